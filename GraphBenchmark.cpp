@@ -0,0 +1,241 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <random>
+#include <unordered_set>
+#include <thread>
+
+#include "MyGraph_Template.h"
+#include "MyGraphMatrix_c336t319.h"
+#include "MyVector_c336t319.h"
+#include "MyThreadPool_c336t319.h"
+
+using namespace std;
+
+typedef MyGraph<unsigned, unsigned> BenchGraphType;
+
+// generates num_edges distinct uniform random (Erdos-Renyi style) edges over num_vertices vertices with IDs 1..num_vertices
+void randomEdges(MyVector<BenchGraphType::EdgeRecord>& edges, const size_t num_vertices, const size_t num_edges, const unsigned seed)
+{
+    mt19937_64 rng(seed);
+    unordered_set<unsigned long long> seen;
+    edges.resize(0);
+    edges.reserve(num_edges);
+    while(edges.size() < num_edges)
+    {
+        unsigned long long a = rng() % num_vertices;
+        unsigned long long b = rng() % num_vertices;
+        if(a == b)
+            continue;
+        if(a > b)
+            swap(a, b);
+        if(!seen.insert(a * num_vertices + b).second)
+            continue;
+        edges.push_back(BenchGraphType::EdgeRecord(static_cast<VertexIDType>(a + 1), static_cast<VertexIDType>(b + 1), static_cast<unsigned>(rng() % 1000)));
+    }
+    return;
+}
+
+// returns the best wall-clock time (in milliseconds) of func over num_runs runs
+template <typename FuncType>
+double bestOf(const int num_runs, FuncType func)
+{
+    double best = -1;
+    for(int r = 0; r < num_runs; ++ r)
+    {
+        auto start = chrono::steady_clock::now();
+        func();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if(best < 0 || ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc < 3 || argc > 4)
+    {
+        cout << "Usage: " << argv[0] << " <num_vertices> <num_edges> [max_threads]" << endl;
+        exit(1);
+    }
+    size_t num_vertices = stoull(argv[1]);
+    size_t num_edges = stoull(argv[2]);
+    size_t max_threads = (argc == 4 ? stoull(argv[3]) : max(1u, thread::hardware_concurrency()));
+    const int num_runs = 3;
+
+    MyVector<unsigned> vertex_data(num_vertices);
+    for(size_t i = 0; i < num_vertices; ++ i)
+        vertex_data[i] = static_cast<unsigned>(i);
+    MyVector<BenchGraphType::EdgeRecord> edges;
+    randomEdges(edges, num_vertices, num_edges, 42);
+
+    // construction: per-element addVertex/addEdge against the bulk builders
+    double single_ms = bestOf(1, [&]()
+    {
+        BenchGraphType single;
+        for(size_t i = 0; i < num_vertices; ++ i)
+            single.addVertex(vertex_data[i]);
+        for(size_t i = 0; i < edges.size(); ++ i)
+            single.addEdge(edges[i].src, edges[i].tgt, edges[i].data);
+    });
+    BenchGraphType graph;
+    double bulk_ms = bestOf(1, [&]()
+    {
+        graph.addVertices(vertex_data);
+        graph.addEdges(edges);
+    });
+    cout << "graph: " << graph.numVertices() << " vertices, " << graph.numEdges() << " edges" << endl;
+    cout << "addVertex/addEdge build:\t" << single_ms << " ms" << endl;
+    cout << "addVertices/addEdges build:\t" << bulk_ms << " ms" << endl;
+
+    // serial baseline
+    MyVector<VertexIDType> path;
+    double serial_ms = bestOf(num_runs, [&]() { graph.breadthFirstSearch(1, path, BFS_DIRECTION_OPTIMIZING); });
+    cout << "breadthFirstSearch (direction-opt):\t" << serial_ms << " ms\t" << path.size() << " vertices reached" << endl;
+
+    // parallel BFS at doubling thread counts
+    MyVector<long long> level;
+    MyVector<VertexIDType> parent;
+    for(size_t t = 1; ; t = min(2 * t, max_threads))
+    {
+        MyThreadPool pool(t);
+        double par_ms = bestOf(num_runs, [&]() { graph.parallelBreadthFirstSearch(1, path, level, parent, pool); });
+        cout << "parallelBreadthFirstSearch (" << t << " threads):\t" << par_ms << " ms\t" << path.size() << " vertices reached"
+             << "\tspeedup vs serial: " << serial_ms / par_ms << endl;
+        if(t == max_threads)
+            break;
+    }
+
+    // connected components: one BFS per unlabeled vertex against the parallel labeling
+    MyVector<VertexIDType> labels;
+    size_t bfs_components = 0;
+    double bfs_cc_ms = bestOf(1, [&]()
+    {
+        labels.resize(num_vertices + 1);
+        for(size_t i = 0; i <= num_vertices; ++ i)
+            labels[i] = 0;
+        bfs_components = 0;
+        for(VertexIDType v = 1; v <= static_cast<VertexIDType>(num_vertices); ++ v)
+        {
+            if(labels[v] != 0)
+                continue;
+            graph.breadthFirstSearch(v, path, BFS_DIRECTION_OPTIMIZING);
+            for(size_t i = 0; i < path.size(); ++ i)
+                labels[path[i]] = v;
+            ++ bfs_components;
+        }
+    });
+    cout << "components by BFS:\t" << bfs_cc_ms << " ms\t" << bfs_components << " components" << endl;
+    for(size_t t = 1; ; t = min(2 * t, max_threads))
+    {
+        MyThreadPool pool(t);
+        size_t num_components = 0;
+        double par_ms = bestOf(num_runs, [&]() { num_components = graph.connectedComponents(labels, pool); });
+        cout << "connectedComponents (" << t << " threads):\t" << par_ms << " ms\t" << num_components << " components"
+             << "\tspeedup vs BFS: " << bfs_cc_ms / par_ms << endl;
+        if(t == max_threads)
+            break;
+    }
+
+    // triangles: probing every pair of neighbours against the sorted-list intersection
+    MyVector<MyVector<VertexIDType> > nbrs(num_vertices + 1);
+    for(size_t i = 0; i < edges.size(); ++ i)
+    {
+        nbrs[edges[i].src].push_back(edges[i].tgt);
+        nbrs[edges[i].tgt].push_back(edges[i].src);
+    }
+    unsigned long long probe_triangles = 0;
+    double probe_ms = bestOf(1, [&]()
+    {
+        EdgeIDType eid;
+        probe_triangles = 0;
+        for(size_t v = 1; v <= num_vertices; ++ v)
+            for(size_t i = 0; i < nbrs[v].size(); ++ i)
+                for(size_t j = i + 1; j < nbrs[v].size(); ++ j)
+                    probe_triangles += graph.probeEdge(nbrs[v][i], nbrs[v][j], eid);
+        probe_triangles /= 3;
+    });
+    cout << "triangles by probeEdge:\t" << probe_ms << " ms\t" << probe_triangles << " triangles" << endl;
+    cout << "set intersection:\t" << (MySetIntersection::simdIntersect() ? "SSE2" : "scalar") << endl;
+    MyVector<unsigned long long> triangle_counts;
+    MyVector<double> coeffs;
+    for(size_t t = 1; ; t = min(2 * t, max_threads))
+    {
+        MyThreadPool pool(t);
+        unsigned long long triangles = 0;
+        double average = 0;
+        double count_ms = bestOf(num_runs, [&]() { triangles = graph.countTriangles(pool); });
+        double per_vertex_ms = bestOf(num_runs, [&]() { graph.countTriangles(triangle_counts, pool); });
+        double coeff_ms = bestOf(num_runs, [&]() { average = graph.clusteringCoefficients(coeffs, pool); });
+        cout << "countTriangles (" << t << " threads):\t" << count_ms << " ms\t" << triangles << " triangles"
+             << "\tspeedup vs probeEdge: " << probe_ms / count_ms << endl;
+        cout << "countTriangles per vertex (" << t << " threads):\t" << per_vertex_ms << " ms" << endl;
+        cout << "clusteringCoefficients (" << t << " threads):\t" << coeff_ms << " ms\taverage " << average << endl;
+        if(t == max_threads)
+            break;
+    }
+
+    // PageRank over the CSR matrix (unweighted and weighted by the edge property), with per-iteration times
+    MyGraphMatrix<unsigned, unsigned> matrix;
+    MyGraphMatrix<unsigned, unsigned> weighted_matrix;
+    double matrix_ms = bestOf(1, [&]() { matrix.build(graph); });
+    double weighted_matrix_ms = bestOf(1, [&]() { weighted_matrix.build(graph, true); });
+    cout << "MyGraphMatrix build:\t" << matrix_ms << " ms\t(weighted " << weighted_matrix_ms << " ms)\t"
+         << matrix.memoryUsage() << " bytes" << endl;
+    MyVector<double> x(matrix.numVertices()), y, ranks;
+    for(size_t i = 0; i < x.size(); ++ i)
+        x[i] = 1;
+    MyGraphMatrix<unsigned, unsigned>::IterationReport report;
+    for(size_t t = 1; ; t = min(2 * t, max_threads))
+    {
+        MyThreadPool pool(t);
+        double spmv_ms = bestOf(num_runs, [&]() { matrix.multiply(x, y, pool); });
+        cout << "multiply (" << t << " threads):\t" << spmv_ms << " ms" << endl;
+        for(int w = 0; w < 2; ++ w)
+        {
+            const MyGraphMatrix<unsigned, unsigned>& m = (w == 0 ? matrix : weighted_matrix);
+            double rank_ms = bestOf(1, [&]() { m.pageRank(ranks, pool, 0.85, 1e-9, 100, &report); });
+            double per_iteration = 0;
+            for(size_t i = 0; i < report.iteration_ms.size(); ++ i)
+                per_iteration += report.iteration_ms[i];
+            per_iteration /= max<size_t>(1, report.iterations);
+            cout << "pageRank" << (w == 0 ? "" : " weighted") << " (" << t << " threads):\t" << rank_ms << " ms\t"
+                 << report.iterations << " iterations" << (report.converged ? "" : " (not converged)")
+                 << "\t" << per_iteration << " ms per iteration" << endl;
+        }
+        if(t == max_threads)
+            break;
+    }
+
+    // minimum spanning forest by the edge property: sequential Kruskal over the edge records against both algorithms
+    MyVector<size_t> order(edges.size());
+    size_t kruskal_edges = 0;
+    double kruskal_ms = bestOf(1, [&]()
+    {
+        for(size_t i = 0; i < order.size(); ++ i)
+            order[i] = i;
+        sort(order.begin(), order.begin() + order.size(), [&](size_t a, size_t b)
+        {
+            return edges[a].data < edges[b].data || (edges[a].data == edges[b].data && a < b);
+        });
+        MyDisjointSet sets(num_vertices + 1);
+        kruskal_edges = 0;
+        for(size_t i = 0; i < order.size(); ++ i)
+            kruskal_edges += sets.unite(edges[order[i]].src, edges[order[i]].tgt);
+    });
+    cout << "Kruskal on the edge records:\t" << kruskal_ms << " ms\t" << kruskal_edges << " forest edges" << endl;
+    MyVector<EdgeIDType> forest;
+    for(size_t t = 1; ; t = min(2 * t, max_threads))
+    {
+        MyThreadPool pool(t);
+        double boruvka_ms = bestOf(num_runs, [&]() { graph.minimumSpanningForest(forest, pool, MSF_BORUVKA); });
+        cout << "minimumSpanningForest Boruvka (" << t << " threads):\t" << boruvka_ms << " ms\t" << forest.size() << " forest edges" << endl;
+        double filter_ms = bestOf(num_runs, [&]() { graph.minimumSpanningForest(forest, pool, MSF_FILTER_KRUSKAL); });
+        cout << "minimumSpanningForest filter-Kruskal (" << t << " threads):\t" << filter_ms << " ms\t" << forest.size() << " forest edges" << endl;
+        if(t == max_threads)
+            break;
+    }
+
+    return 0;
+}
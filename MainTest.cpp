@@ -7,6 +7,9 @@
 #include "MyGraph_Template.h"
 #include "MyVector_c336t319.h"
 #include "MyHashTable_c336t319.h"
+#include "MyThreadPool_c336t319.h"
+#include "MyGraphLoader_c336t319.h"
+#include "MyGraphLog_c336t319.h"
 
 using namespace std;
 
@@ -22,84 +25,29 @@ int main(int argc, char* argv[])
     }
 
     MyGraph<CityNameType, DistanceType> graph;
-    MyHashTable<CityNameType, VertexIDType> city_hashmap;
+    MyNameIndex city_index;
     MyVector<CityNameType> cities;
+    MyThreadPool pool;
 
-    // testing adding vertices
-    ifstream inFile1;
-    inFile1.open(argv[1]);
-    if(inFile1.is_open())
-    {
-        string line;
-        while(getline(inFile1, line))
-        {
-            cout << "Adding vertex:\t" << line << endl;
-            VertexIDType vid = graph.addVertex(line);   
-            cout << "Vertex added with assigned ID:\t" << vid << endl;
-            MyGraph<CityNameType, DistanceType>::Vertex* vx = graph.getVertex(vid);
-            cout << "Retrieved vertex:\t" << vx->data << endl;
-
-            // adding the vertex to hash table
-            HashedObj<CityNameType, VertexIDType> v_record(line, vid);
-            city_hashmap.insert(std::move(v_record));
-            cities.push_back(line);
-        }
-        inFile1.close();
-    }
+    // loading the vertices and the edges (parsed in parallel, added with the bulk builders)
+    if(MyGraphLoader<DistanceType>::loadVertices(argv[1], graph, cities, city_index, pool))
+        cout << "Vertices loaded:\t" << cities.size() << endl;
     else
-    {
         cout << "The graph vertex input file cannot be opened." << endl;
-    }
-
-    // testing adding edges
-    ifstream inFile2;
-    inFile2.open(argv[2]);
-    if(inFile2.is_open())
-    {
-        string line;
-        CityNameType city1, city2;
-        DistanceType dist;
-        while(getline(inFile2, line))
-        {
-
-            std::stringstream ss;
-            ss.str(line);
-            ss >> city1 >> city2 >> dist;
-
-            //adding
-            std::cout << "Looking up >" << city1 << "< and >" << city2 << "<(rawline was: \"" << line << "\")\n";
-            //
-
-            HashedObj<CityNameType, VertexIDType> v_record_1, v_record_2;
-            if(city_hashmap.retrieve(city1, v_record_1) && city_hashmap.retrieve(city2, v_record_2))
-            {
-                // add the edge
-                cout << "Adding edge:\t" << city1 << "\t" << city2 << "\t" << dist << endl;  
-                EdgeIDType eid = graph.addEdge(v_record_1.value, v_record_2.value, std::move(dist));
-                cout << "Edge added with assigned ID:\t" << eid << endl; 
-                MyGraph<CityNameType, DistanceType>::Edge* eg = graph.getEdge(eid);
-                cout << "Retrieved edge:\t" << eg->src << "\t" << eg->tgt << "\t" << eg->data << endl;
-            }
-            else
-                throw std::domain_error("Main(MyGraph): adding edge between nodes that do not exist.");
-
-        }
-        inFile2.close();
-    }
+    if(MyGraphLoader<DistanceType>::loadEdges(argv[2], graph, city_index, pool))
+        cout << "Edges loaded:\t" << graph.numEdges() << endl;
     else
-    {
         cout << "The graph edge input file cannot be opened." << endl;
-    }
 
     graph.printAdjList();
 
     // testing vertex degree
     for(size_t i = 0; i < cities.size(); ++ i)
     {
-        HashedObj<CityNameType, VertexIDType> v_record;
-        if(city_hashmap.retrieve(cities[i], v_record))
+        VertexIDType vid;
+        if(city_index.get(cities[i], vid))
         {
-            size_t dg = graph.degree(v_record.value);
+            size_t dg = graph.degree(vid);
             cout << "The degree of vertex " << cities[i] << " is:\t" << dg << endl;
         }
     }
@@ -112,11 +60,11 @@ int main(int argc, char* argv[])
         v2 = static_cast<VertexIDType>((int) rand() % cities.size());
         if(v1 == v2)    continue;
 
-        HashedObj<CityNameType, VertexIDType> v_record_1, v_record_2;
-        if(city_hashmap.retrieve(cities[v1], v_record_1) && city_hashmap.retrieve(cities[v2], v_record_2))
+        VertexIDType vid_1, vid_2;
+        if(city_index.get(cities[v1], vid_1) && city_index.get(cities[v2], vid_2))
         {                
             EdgeIDType eid;
-            if(graph.probeEdge(v_record_1.value, v_record_2.value, eid))
+            if(graph.probeEdge(vid_1, vid_2, eid))
                 cout << "The distance between the cities " << cities[v1] << " and " << cities[v2] << " is " << graph.getEdge(eid)->data << endl; 
                 
             else
@@ -125,23 +73,102 @@ int main(int argc, char* argv[])
         else
             throw std::domain_error("Main(MyGraph): trying to find edges between nodes that do not exist.");
 
-        if(graph.isConnected(v_record_1.value, v_record_2.value))
+        if(graph.isConnected(vid_1, vid_2))
             cout << "The cities " << cities[v1] << " and " << cities[v2] << " are connected." << endl;
         else
             cout << "The cities " << cities[v1] << " and " << cities[v2] << " are not connected." << endl;
 
     }
 
+    // testing edge probing with parallel edges (a remaining parallel edge must still be found after the first one is deleted)
+    for(int matrix = 0; matrix < 2; ++ matrix)
+    {
+        MyGraph<CityNameType, DistanceType> parallel;
+        parallel.setAdjacencyMatrix(matrix == 1);
+        VertexIDType pa = parallel.addVertex("A");
+        VertexIDType pb = parallel.addVertex("B");
+        EdgeIDType first = parallel.addEdge(pa, pb, 1);
+        EdgeIDType second = parallel.addEdge(pb, pa, 2);
+        EdgeIDType third = parallel.addEdge(pa, pb, 3);
+        EdgeIDType found;
+        parallel.deleteEdge(first);
+        if(!parallel.probeEdge(pa, pb, found) || found != second || !parallel.probeEdge(pb, pa, found) || found != second)
+            throw std::domain_error("Main(MyGraph): a parallel edge is not found after deleting the first one.");
+        parallel.deleteEdge(second);
+        if(!parallel.probeEdge(pa, pb, found) || found != third)
+            throw std::domain_error("Main(MyGraph): a parallel edge is not found after deleting the first one.");
+        parallel.deleteEdge(third);
+        if(parallel.probeEdge(pa, pb, found))
+            throw std::domain_error("Main(MyGraph): an edge is found after deleting every parallel edge.");
+    }
+    cout << "Parallel edge probing:\tpassed" << endl;
+
+    // testing log recovery from an empty log file (a crash right after the log was created, before its header)
+    {
+        const string log_base = "MainTest.recovery";
+        ofstream(log_base + ".0.wal", ios::out | ios::binary | ios::trunc).close();
+        MyGraph<CityNameType, DistanceType> logged;
+        MyGraphLog<CityNameType, DistanceType> log;
+        if(!log.open(log_base, logged))
+            throw std::domain_error("Main(MyGraph): the log cannot be opened over an empty log file.");
+        VertexIDType la = logged.addVertex("A");
+        VertexIDType lb = logged.addVertex("B");
+        logged.addEdge(la, lb, 7);
+        if(!log.close())
+            throw std::domain_error("Main(MyGraph): the log cannot be written.");
+        MyGraph<CityNameType, DistanceType> recovered;
+        if(!log.open(log_base, recovered) || recovered.numVertices() != 2 || recovered.numEdges() != 1)
+            throw std::domain_error("Main(MyGraph): the log is not recovered after starting from an empty log file.");
+        log.close();
+        std::remove((log_base + ".manifest").c_str());
+        for(unsigned long long g = 0; g <= log.currentGeneration(); ++ g)
+        {
+            std::remove((log_base + "." + to_string(g) + ".snap").c_str());
+            std::remove((log_base + "." + to_string(g) + ".wal").c_str());
+        }
+    }
+    cout << "Log recovery from an empty log file:\tpassed" << endl;
+
+    // testing automatic checkpoints (the log is replaced once it holds 1 KB)
+    {
+        const string log_base = "MainTest.checkpoint";
+        MyGraph<CityNameType, DistanceType> logged;
+        MyGraphLog<CityNameType, DistanceType> log(1 << 16, 10, 1 << 10);
+        if(!log.open(log_base, logged))
+            throw std::domain_error("Main(MyGraph): the log cannot be opened.");
+        VertexIDType prev = logged.addVertex("V");
+        for(size_t i = 0; i < 200; ++ i)
+        {
+            VertexIDType next = logged.addVertex("V");
+            logged.addEdge(prev, next, static_cast<DistanceType>(i));
+            prev = next;
+        }
+        if(!log.close() || log.currentGeneration() == 0)
+            throw std::domain_error("Main(MyGraph): the log is not checkpointed automatically.");
+        MyGraph<CityNameType, DistanceType> recovered;
+        if(!log.open(log_base, recovered) || recovered.numVertices() != 201 || recovered.numEdges() != 200)
+            throw std::domain_error("Main(MyGraph): the log is not recovered after automatic checkpoints.");
+        log.close();
+        std::remove((log_base + ".manifest").c_str());
+        std::remove((log_base + "." + to_string(log.currentGeneration()) + ".snap").c_str());
+        std::remove((log_base + "." + to_string(log.currentGeneration()) + ".wal").c_str());
+    }
+    cout << "Automatic log checkpoints:\tpassed" << endl;
+
     // testing graph traversal
+    // vertex IDs start from 1, so traverse from the first city's ID
     MyVector<VertexIDType> path_bfs, path_dfs;
-    graph.breadthFirstSearch(0, path_bfs);
+    VertexIDType first_vid;
+    if(cities.empty() || !city_index.get(cities[0], first_vid))
+        throw std::domain_error("Main(MyGraph): no vertex to start the traversals from.");
+    graph.breadthFirstSearch(first_vid, path_bfs);
     cout << "BFS path: " << endl;
     for(size_t i = 0; i < path_bfs.size(); ++ i)
     {
         cout << path_bfs[i] << "\t";
     }
     cout << endl;
-    graph.depthFirstSearch(0, path_dfs);
+    graph.depthFirstSearch(first_vid, path_dfs);
     cout << "DFS path: " << endl;
     for(size_t i = 0; i < path_dfs.size(); ++ i)
     {
@@ -149,24 +176,41 @@ int main(int argc, char* argv[])
     }
     cout << endl;
 
+    // testing the minimum spanning forest (both algorithms return the same edges)
+    MyVector<EdgeIDType> forest_boruvka, forest_kruskal;
+    graph.minimumSpanningForest(forest_boruvka, pool, MSF_BORUVKA);
+    graph.minimumSpanningForest(forest_kruskal, pool, MSF_FILTER_KRUSKAL);
+    if(forest_boruvka.size() != forest_kruskal.size())
+        throw std::domain_error("Main(MyGraph): the minimum spanning forests differ.");
+    unsigned long long forest_distance = 0;
+    for(size_t i = 0; i < forest_boruvka.size(); ++ i)
+    {
+        if(forest_boruvka[i] != forest_kruskal[i])
+            throw std::domain_error("Main(MyGraph): the minimum spanning forests differ.");
+        forest_distance += graph.getEdge(forest_boruvka[i])->data;
+    }
+    cout << "Minimum spanning forest: " << forest_boruvka.size() << " edges, total distance " << forest_distance << endl;
+
     // testing vertex deletion
     MyVector<bool> city_deleted(cities.size());
     for(size_t i = 0; i < city_deleted.size(); ++ i)
         city_deleted[i] = false;
 
+    MyVector<VertexIDType> to_delete;
     for(size_t i = 0; i < 1000; ++ i)
     {
         VertexIDType vd = static_cast<VertexIDType>((int) rand() % cities.size());
         if(city_deleted[vd])
             continue;
 
-        HashedObj<CityNameType, VertexIDType> v_record;
-        if(city_hashmap.retrieve(cities[vd], v_record))
+        VertexIDType vid;
+        if(city_index.get(cities[vd], vid))
         {
-            graph.deleteVertex(v_record.value);
+            to_delete.push_back(vid);
         }
         city_deleted[vd] = true;
     }
+    graph.deleteVertices(to_delete);
     graph.printInfoVertexMap();
     graph.printInfoEdgeMap();
     graph.printAdjList();
@@ -175,10 +219,10 @@ int main(int argc, char* argv[])
         if(city_deleted[i])
             continue;
 
-        HashedObj<CityNameType, VertexIDType> v_record;
-        if(city_hashmap.retrieve(cities[i], v_record))
+        VertexIDType vid;
+        if(city_index.get(cities[i], vid))
         {
-            graph.deleteVertex(v_record.value);
+            graph.deleteVertex(vid);
         }
         city_deleted[i] = true;
     }
@@ -0,0 +1,708 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <vector>
+#include <list>
+#include <queue>
+#include <stack>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "MyGraph_Template.h"
+#include "MyGraphColumns_c336t319.h"
+#include "MyGraphLog_c336t319.h"
+#include "MyGraphView_c336t319.h"
+#include "MyVector_c336t319.h"
+#include "MyLinkedList_c336t319.h"
+#include "MyQueue_c336t319.h"
+#include "MyStack_c336t319.h"
+#include "MyHashTable_c336t319.h"
+
+using namespace std;
+
+typedef MyGraph<unsigned, unsigned> BenchGraphType;
+
+// one measurement; printed as a CSV row or a JSON object
+struct BenchResult
+{
+    string suite;           // "container" or "graph"
+    string name;            // the operation measured
+    string impl;            // "My" or "std" for containers, the graph model for graphs
+    string workload;        // free-form parameters of the run (load factor, graph size, ...)
+    size_t ops;             // the number of operations timed
+    double ms;              // the best wall-clock time over the runs
+};
+
+MyVector<BenchResult> results;
+volatile unsigned long long bench_sink = 0;     // keeps the optimizer from dropping the benchmarked work
+
+// returns the best wall-clock time (in milliseconds) of func over num_runs runs
+template <typename FuncType>
+double bestOf(const int num_runs, FuncType func)
+{
+    double best = -1;
+    for(int r = 0; r < num_runs; ++ r)
+    {
+        auto start = chrono::steady_clock::now();
+        func();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if(best < 0 || ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+// times func and appends the result
+template <typename FuncType>
+void record(const string& suite, const string& name, const string& impl, const string& workload, const size_t ops, const int num_runs, FuncType func)
+{
+    BenchResult r;
+    r.suite = suite;
+    r.name = name;
+    r.impl = impl;
+    r.workload = workload;
+    r.ops = ops;
+    r.ms = bestOf(num_runs, func);
+    results.push_back(r);
+    cerr << suite << "/" << name << " [" << impl << ", " << workload << "]: " << r.ms << " ms" << endl;
+    return;
+}
+
+/*****************************************************************************************
+ * containers
+ *****************************************************************************************/
+
+void benchVector(const size_t n)
+{
+    string w = "n=" + to_string(n);
+    record("container", "vector_push_back", "My", w, n, 3, [&]()
+    {
+        MyVector<unsigned long long> v;
+        for(size_t i = 0; i < n; ++ i)
+            v.push_back(i);
+        bench_sink += v[n / 2];
+    });
+    record("container", "vector_push_back", "std", w, n, 3, [&]()
+    {
+        vector<unsigned long long> v;
+        for(size_t i = 0; i < n; ++ i)
+            v.push_back(i);
+        bench_sink += v[n / 2];
+    });
+    record("container", "vector_reserve_push_back", "My", w, n, 3, [&]()
+    {
+        MyVector<unsigned long long> v;
+        v.reserve(n);
+        for(size_t i = 0; i < n; ++ i)
+            v.push_back(i);
+        bench_sink += v[n / 2];
+    });
+    record("container", "vector_reserve_push_back", "std", w, n, 3, [&]()
+    {
+        vector<unsigned long long> v;
+        v.reserve(n);
+        for(size_t i = 0; i < n; ++ i)
+            v.push_back(i);
+        bench_sink += v[n / 2];
+    });
+    return;
+}
+
+// builds a list of n elements with push_back, then erases every other element and inserts a new one before each survivor
+template <typename ListType>
+void listChurn(const size_t n)
+{
+    ListType l;
+    for(size_t i = 0; i < n; ++ i)
+        l.push_back(i);
+    bool drop = true;
+    for(auto itr = l.begin(); itr != l.end(); )
+    {
+        if(drop)
+            itr = l.erase(itr);
+        else
+        {
+            l.insert(itr, 0);
+            ++itr;
+        }
+        drop = !drop;
+    }
+    bench_sink += l.size();
+    return;
+}
+
+void benchList(const size_t n)
+{
+    string w = "n=" + to_string(n);
+    record("container", "list_insert_erase", "My", w, 2 * n, 3, [&]() { listChurn<MyLinkedList<unsigned long long> >(n); });
+    record("container", "list_insert_erase", "std", w, 2 * n, 3, [&]() { listChurn<list<unsigned long long> >(n); });
+    return;
+}
+
+// keeps depth elements in a queue and performs n enqueue/dequeue pairs
+void benchQueueStack(const size_t n, const size_t depth)
+{
+    string w = "n=" + to_string(n) + ";depth=" + to_string(depth);
+    record("container", "queue_churn", "My", w, 2 * n, 3, [&]()
+    {
+        MyQueue<unsigned long long> q;
+        for(size_t i = 0; i < depth; ++ i)
+            q.enqueue(i);
+        unsigned long long sum = 0;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            q.enqueue(i);
+            sum += q.front();
+            q.dequeue();
+        }
+        bench_sink += sum;
+    });
+    record("container", "queue_churn", "std", w, 2 * n, 3, [&]()
+    {
+        queue<unsigned long long> q;
+        for(size_t i = 0; i < depth; ++ i)
+            q.push(i);
+        unsigned long long sum = 0;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            q.push(i);
+            sum += q.front();
+            q.pop();
+        }
+        bench_sink += sum;
+    });
+    record("container", "stack_churn", "My", w, 2 * n, 3, [&]()
+    {
+        MyStack<unsigned long long> s;
+        for(size_t i = 0; i < depth; ++ i)
+            s.push(i);
+        unsigned long long sum = 0;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            s.push(i);
+            sum += s.top();
+            s.pop();
+        }
+        bench_sink += sum;
+    });
+    record("container", "stack_churn", "std", w, 2 * n, 3, [&]()
+    {
+        stack<unsigned long long> s;
+        for(size_t i = 0; i < depth; ++ i)
+            s.push(i);
+        unsigned long long sum = 0;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            s.push(i);
+            sum += s.top();
+            s.pop();
+        }
+        bench_sink += sum;
+    });
+    return;
+}
+
+// insert/lookup/remove of n random keys into tables presized for load_factor
+// MyHashTable doubles once it is half full, so its load factor stays below 0.5
+void benchHashTable(const size_t n, const double load_factor)
+{
+    mt19937_64 rng(7);
+    MyVector<long long> keys(n), misses(n);
+    for(size_t i = 0; i < n; ++ i)
+    {
+        // keys stay below 2^41, the range the universal hash handles without overflowing
+        keys[i] = static_cast<long long>(rng() >> 24) * 2;      // even keys are inserted
+        misses[i] = static_cast<long long>(rng() >> 24) * 2 + 1; // odd keys are never present
+    }
+    size_t buckets = static_cast<size_t>(n / load_factor);
+
+    MyHashTable<long long, long long> my_table;
+    my_table.reserve(buckets / 2);
+    unordered_map<long long, long long> std_table;
+    std_table.max_load_factor(1.0f);
+    std_table.rehash(buckets);
+
+    string w = "n=" + to_string(n) + ";load_factor=" + to_string(load_factor);
+    record("container", "hash_insert", "My", w, n, 1, [&]()
+    {
+        for(size_t i = 0; i < n; ++ i)
+            my_table.insert(HashedObj<long long, long long>(keys[i], static_cast<long long>(i)));
+    });
+    record("container", "hash_insert", "std", w, n, 1, [&]()
+    {
+        for(size_t i = 0; i < n; ++ i)
+            std_table.emplace(keys[i], static_cast<long long>(i));
+    });
+    record("container", "hash_lookup_hit", "My", w, n, 3, [&]()
+    {
+        long long v, sum = 0;
+        for(size_t i = 0; i < n; ++ i)
+            if(my_table.get(keys[i], v))
+                sum += v;
+        bench_sink += sum;
+    });
+    record("container", "hash_lookup_hit", "std", w, n, 3, [&]()
+    {
+        long long sum = 0;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            auto itr = std_table.find(keys[i]);
+            if(itr != std_table.end())
+                sum += itr->second;
+        }
+        bench_sink += sum;
+    });
+    record("container", "hash_lookup_miss", "My", w, n, 3, [&]()
+    {
+        long long v, cnt = 0;
+        for(size_t i = 0; i < n; ++ i)
+            cnt += my_table.get(misses[i], v);
+        bench_sink += cnt;
+    });
+    record("container", "hash_lookup_miss", "std", w, n, 3, [&]()
+    {
+        long long cnt = 0;
+        for(size_t i = 0; i < n; ++ i)
+            cnt += (std_table.find(misses[i]) != std_table.end());
+        bench_sink += cnt;
+    });
+    record("container", "hash_remove", "My", w, n, 1, [&]()
+    {
+        for(size_t i = 0; i < n; ++ i)
+            my_table.remove(keys[i]);
+    });
+    record("container", "hash_remove", "std", w, n, 1, [&]()
+    {
+        for(size_t i = 0; i < n; ++ i)
+            std_table.erase(keys[i]);
+    });
+    return;
+}
+
+/*****************************************************************************************
+ * synthetic graphs
+ *****************************************************************************************/
+
+// appends the undirected edge {a, b} (0-based) unless it is a self-loop or a duplicate
+bool appendEdge(MyVector<BenchGraphType::EdgeRecord>& edges, unordered_set<unsigned long long>& seen,
+                unsigned long long a, unsigned long long b, const unsigned long long num_vertices, mt19937_64& rng)
+{
+    if(a == b)
+        return false;
+    if(a > b)
+        swap(a, b);
+    if(!seen.insert(a * num_vertices + b).second)
+        return false;
+    edges.push_back(BenchGraphType::EdgeRecord(static_cast<VertexIDType>(a + 1), static_cast<VertexIDType>(b + 1), static_cast<unsigned>(rng() % 1000)));
+    return true;
+}
+
+// Erdos-Renyi style: num_edges distinct uniform random edges over num_edges / 4 vertices (average degree 8)
+size_t erdosRenyi(MyVector<BenchGraphType::EdgeRecord>& edges, const size_t num_edges, const unsigned seed)
+{
+    size_t n = max<size_t>(16, num_edges / 4);
+    mt19937_64 rng(seed);
+    unordered_set<unsigned long long> seen;
+    edges.resize(0);
+    edges.reserve(num_edges);
+    while(edges.size() < num_edges)
+        appendEdge(edges, seen, rng() % n, rng() % n, n, rng);
+    return n;
+}
+
+// R-MAT (a, b, c, d) = (0.57, 0.19, 0.19, 0.05): skewed degrees as in social and web graphs
+// uses the smallest power of two number of vertices with average degree at most 16
+size_t rmat(MyVector<BenchGraphType::EdgeRecord>& edges, const size_t num_edges, const unsigned seed)
+{
+    size_t scale = 4;
+    while((1ULL << scale) * 8 < num_edges)
+        ++ scale;
+    size_t n = 1ULL << scale;
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    unordered_set<unsigned long long> seen;
+    edges.resize(0);
+    edges.reserve(num_edges);
+    while(edges.size() < num_edges)
+    {
+        unsigned long long a = 0, b = 0;
+        for(size_t bit = 0; bit < scale; ++ bit)
+        {
+            double p = coin(rng);
+            a = (a << 1) | (p >= 0.76 ? 1 : 0);                  // quadrants c and d
+            b = (b << 1) | ((p >= 0.57 && p < 0.76) || p >= 0.95 ? 1 : 0);  // quadrants b and d
+        }
+        appendEdge(edges, seen, a, b, n, rng);
+    }
+    return n;
+}
+
+// a side x side 4-neighbour grid (about 2 * side^2 edges): long paths and low degree as in road networks
+size_t grid(MyVector<BenchGraphType::EdgeRecord>& edges, const size_t num_edges, const unsigned seed)
+{
+    size_t side = max<size_t>(2, static_cast<size_t>(sqrt(num_edges / 2.0)));
+    mt19937_64 rng(seed);
+    edges.resize(0);
+    edges.reserve(2 * side * side);
+    for(size_t r = 0; r < side; ++ r)
+    {
+        for(size_t c = 0; c < side; ++ c)
+        {
+            VertexIDType v = static_cast<VertexIDType>(r * side + c + 1);
+            if(c + 1 < side)
+                edges.push_back(BenchGraphType::EdgeRecord(v, v + 1, static_cast<unsigned>(rng() % 1000)));
+            if(r + 1 < side)
+                edges.push_back(BenchGraphType::EdgeRecord(v, static_cast<VertexIDType>(v + side), static_cast<unsigned>(rng() % 1000)));
+        }
+    }
+    return side * side;
+}
+
+// runs the graph operations on one synthetic graph
+void benchGraph(const string& model, const size_t num_vertices, const MyVector<BenchGraphType::EdgeRecord>& edges)
+{
+    size_t m = edges.size();
+    string w = "vertices=" + to_string(num_vertices) + ";edges=" + to_string(m);
+    MyVector<unsigned> vertex_data(num_vertices);
+    for(size_t i = 0; i < num_vertices; ++ i)
+        vertex_data[i] = static_cast<unsigned>(i);
+    mt19937_64 rng(11);
+
+    record("graph", "build_addVertex_addEdge", model, w, num_vertices + m, 1, [&]()
+    {
+        BenchGraphType single;
+        for(size_t i = 0; i < num_vertices; ++ i)
+            single.addVertex(vertex_data[i]);
+        for(size_t i = 0; i < m; ++ i)
+            single.addEdge(edges[i].src, edges[i].tgt, edges[i].data);
+        bench_sink += single.numEdges();
+    });
+    // the same with every mutation written to the write-ahead log (group commit; the final sync included)
+    const char* log_path = "MicroBenchmark.log";
+    record("graph", "build_addVertex_addEdge_logged", model, w, num_vertices + m, 1, [&]()
+    {
+        BenchGraphType single;
+        MyGraphLog<unsigned, unsigned> log;
+        log.open(log_path, single);
+        for(size_t i = 0; i < num_vertices; ++ i)
+            single.addVertex(vertex_data[i]);
+        for(size_t i = 0; i < m; ++ i)
+            single.addEdge(edges[i].src, edges[i].tgt, edges[i].data);
+        log.close();
+        bench_sink += single.numEdges() + log.numSyncs();
+    });
+    remove((string(log_path) + ".0.wal").c_str());
+    BenchGraphType graph;
+    record("graph", "build_addVertices_addEdges", model, w, num_vertices + m, 1, [&]()
+    {
+        graph.addVertices(vertex_data);
+        graph.addEdges(edges);
+    });
+
+    // half of the probes hit an existing edge, half are random pairs
+    size_t num_probes = min<size_t>(m, 1000000);
+    MyVector<VertexIDType> probe_src(num_probes), probe_tgt(num_probes);
+    for(size_t i = 0; i < num_probes; ++ i)
+    {
+        if(i % 2 == 0)
+        {
+            const BenchGraphType::EdgeRecord& rec = edges[rng() % m];
+            probe_src[i] = rec.src;
+            probe_tgt[i] = rec.tgt;
+        }
+        else
+        {
+            probe_src[i] = static_cast<VertexIDType>(rng() % num_vertices + 1);
+            probe_tgt[i] = static_cast<VertexIDType>(rng() % num_vertices + 1);
+        }
+    }
+    record("graph", "probeEdge", model, w, num_probes, 3, [&]()
+    {
+        EdgeIDType eid;
+        size_t hits = 0;
+        for(size_t i = 0; i < num_probes; ++ i)
+            hits += graph.probeEdge(probe_src[i], probe_tgt[i], eid);
+        bench_sink += hits;
+    });
+    record("graph", "isConnected_index", model, w, num_probes, 3, [&]()
+    {
+        size_t cnt = 0;
+        for(size_t i = 0; i < num_probes; ++ i)
+            cnt += graph.isConnected(probe_src[i], probe_tgt[i]);
+        bench_sink += cnt;
+    });
+    size_t num_searches = min<size_t>(num_probes, 100);
+    graph.setConnectivityIndex(false);
+    record("graph", "isConnected_search", model, w, num_searches, 1, [&]()
+    {
+        size_t cnt = 0;
+        for(size_t i = 1; i < 2 * num_searches; i += 2)
+            cnt += graph.isConnected(probe_src[i], probe_tgt[i]);
+        bench_sink += cnt;
+    });
+    graph.setConnectivityIndex(true);
+
+    MyVector<VertexIDType> path;
+    record("graph", "breadthFirstSearch_direction_opt", model, w, num_vertices + m, 3, [&]()
+    {
+        graph.breadthFirstSearch(1, path, BFS_DIRECTION_OPTIMIZING);
+        bench_sink += path.size();
+    });
+    record("graph", "breadthFirstSearch_edge_id_order", model, w, num_vertices + m, 3, [&]()
+    {
+        graph.breadthFirstSearch(1, path, BFS_EDGE_ID_ORDER);
+        bench_sink += path.size();
+    });
+    record("graph", "depthFirstSearch", model, w, num_vertices + m, 3, [&]()
+    {
+        graph.depthFirstSearch(1, path);
+        bench_sink += path.size();
+    });
+
+    // the same graph with inline neighbours in the adjacency lists; the workload also records the memory of both graphs
+    {
+        MyGraph<unsigned, unsigned, MyGraphPolicy<false, true> > inline_graph;
+        record("graph", "build_addVertices_addEdges_inline", model, w, num_vertices + m, 1, [&]()
+        {
+            inline_graph.addVertices(vertex_data);
+            inline_graph.addEdges(edges);
+        });
+        results[results.size() - 1].workload += ";memory_bytes=" + to_string(inline_graph.memoryUsage())
+                                                + ";default_memory_bytes=" + to_string(graph.memoryUsage());
+        inline_graph.setConnectivityIndex(false);
+        record("graph", "isConnected_search_inline", model, w, num_searches, 1, [&]()
+        {
+            size_t cnt = 0;
+            for(size_t i = 1; i < 2 * num_searches; i += 2)
+                cnt += inline_graph.isConnected(probe_src[i], probe_tgt[i]);
+            bench_sink += cnt;
+        });
+        record("graph", "breadthFirstSearch_direction_opt_inline", model, w, num_vertices + m, 3, [&]()
+        {
+            inline_graph.breadthFirstSearch(1, path, BFS_DIRECTION_OPTIMIZING);
+            bench_sink += path.size();
+        });
+        record("graph", "reorder_rcm_inline", model, w, num_vertices + m, 1, [&]()
+        {
+            inline_graph.reorder(REORDER_RCM);
+        });
+    }
+
+    // property scans: through getEdge (one object per edge), and over the columns of MyGraphColumns
+    record("graph", "scan_sum_edge_data_getEdge", model, w, m, 3, [&]()
+    {
+        unsigned long long sum = 0;
+        for(EdgeIDType eid = 1; eid <= static_cast<EdgeIDType>(m); ++ eid)
+            sum += graph.getEdge(eid)->data;
+        bench_sink += sum;
+    });
+    record("graph", "scan_filter_edge_data_getEdge", model, w, m, 3, [&]()
+    {
+        MyVector<EdgeIDType> eids;
+        for(EdgeIDType eid = 1; eid <= static_cast<EdgeIDType>(m); ++ eid)
+            if(graph.getEdge(eid)->data < 100)
+                eids.push_back(eid);
+        bench_sink += eids.size();
+    });
+    MyGraphColumns<unsigned, unsigned> columns;
+    record("graph", "columns_build", model, w, num_vertices + m, 1, [&]()
+    {
+        columns.build(graph);
+    });
+    record("graph", "scan_sum_edge_data_columns", model, w, m, 3, [&]()
+    {
+        bench_sink += columns.sumEdgeData<unsigned long long>();
+    });
+    record("graph", "scan_filter_edge_data_columns", model, w, m, 3, [&]()
+    {
+        MyVector<EdgeIDType> eids;
+        columns.filterEdges([](const unsigned d) { return d < 100; }, eids);
+        bench_sink += eids.size();
+    });
+    record("graph", "scan_edge_data_range_columns", model, w, m, 3, [&]()
+    {
+        unsigned lo = 0, hi = 0;
+        columns.edgeDataRange(lo, hi);
+        bench_sink += hi - lo;
+    });
+    columns.clear();
+
+    // the same traversals after each locality reordering (on a fresh copy, so the rows below keep the insertion order)
+    const ReorderStrategy strategies[] = { REORDER_RCM, REORDER_DEGREE_DESCENDING, REORDER_BFS };
+    const char* strategy_names[] = { "rcm", "degree", "bfs" };
+    for(size_t s = 0; s < 3; ++ s)
+    {
+        BenchGraphType reordered;
+        reordered.addVertices(vertex_data);
+        reordered.addEdges(edges);
+        string suffix = strategy_names[s];
+        record("graph", "reorder_" + suffix, model, w, num_vertices + m, 1, [&]()
+        {
+            reordered.reorder(strategies[s]);
+        });
+        record("graph", "breadthFirstSearch_direction_opt_" + suffix, model, w, num_vertices + m, 3, [&]()
+        {
+            reordered.breadthFirstSearch(1, path, BFS_DIRECTION_OPTIMIZING);
+            bench_sink += path.size();
+        });
+        record("graph", "depthFirstSearch_" + suffix, model, w, num_vertices + m, 3, [&]()
+        {
+            reordered.depthFirstSearch(1, path);
+            bench_sink += path.size();
+        });
+    }
+
+    // the binary snapshot, and the same queries on the memory-mapped view of it
+    const char* snapshot_path = "MicroBenchmark.snap";
+    record("graph", "snapshot_save", model, w, num_vertices + m, 1, [&]()
+    {
+        bench_sink += graph.save(snapshot_path);
+    });
+    {
+        BenchGraphType loaded;
+        record("graph", "snapshot_load", model, w, num_vertices + m, 1, [&]()
+        {
+            loaded.load(snapshot_path);
+            bench_sink += loaded.numEdges();
+        });
+    }
+    MyGraphView<unsigned, unsigned> view;
+    record("graph", "view_open", model, w, num_vertices + m, 1, [&]()
+    {
+        view.open(snapshot_path);
+    });
+    record("graph", "view_isConnected_index", model, w, num_probes, 3, [&]()
+    {
+        size_t cnt = 0;
+        for(size_t i = 0; i < num_probes; ++ i)
+            cnt += view.isConnected(probe_src[i], probe_tgt[i]);
+        bench_sink += cnt;
+    });
+    record("graph", "view_breadthFirstSearch_direction_opt", model, w, num_vertices + m, 3, [&]()
+    {
+        view.breadthFirstSearch(1, path, BFS_DIRECTION_OPTIMIZING);
+        bench_sink += path.size();
+    });
+    record("graph", "view_depthFirstSearch", model, w, num_vertices + m, 3, [&]()
+    {
+        view.depthFirstSearch(1, path);
+        bench_sink += path.size();
+    });
+    view.close();
+
+    // the same with the neighbour lists compressed in memory; the workload also records the adjacency bytes
+    // of the snapshot (offsets, edge and neighbour sections) and of the compressed lists
+    MyGraphView<unsigned, unsigned> compressed_view;
+    record("graph", "view_open_compressed", model, w, num_vertices + m, 1, [&]()
+    {
+        compressed_view.open(snapshot_path, VIEW_COMPRESSED);
+    });
+    results[results.size() - 1].workload += ";snapshot_adjacency_bytes=" + to_string(8 * (num_vertices + 1) + 32 * m)
+                                            + ";compressed_bytes=" + to_string(compressed_view.memoryUsage());
+    record("graph", "view_isConnected_index_compressed", model, w, num_probes, 3, [&]()
+    {
+        size_t cnt = 0;
+        for(size_t i = 0; i < num_probes; ++ i)
+            cnt += compressed_view.isConnected(probe_src[i], probe_tgt[i]);
+        bench_sink += cnt;
+    });
+    record("graph", "view_breadthFirstSearch_direction_opt_compressed", model, w, num_vertices + m, 3, [&]()
+    {
+        compressed_view.breadthFirstSearch(1, path, BFS_DIRECTION_OPTIMIZING);
+        bench_sink += path.size();
+    });
+    compressed_view.close();
+    remove(snapshot_path);
+
+    // one-by-one deletes of 10% of the edges, then of 1% of the vertices (edges first, so the vertex deletes see fewer edges)
+    MyVector<EdgeIDType> edge_victims;
+    for(EdgeIDType eid = 1; eid <= static_cast<EdgeIDType>(m); ++ eid)
+        if(rng() % 10 == 0)
+            edge_victims.push_back(eid);
+    record("graph", "deleteEdge", model, w, edge_victims.size(), 1, [&]()
+    {
+        for(size_t i = 0; i < edge_victims.size(); ++ i)
+            graph.deleteEdge(edge_victims[i]);
+    });
+    MyVector<VertexIDType> vertex_victims;
+    for(VertexIDType vid = 1; vid <= static_cast<VertexIDType>(num_vertices); ++ vid)
+        if(rng() % 100 == 0)
+            vertex_victims.push_back(vid);
+    record("graph", "deleteVertex", model, w, vertex_victims.size(), 1, [&]()
+    {
+        for(size_t i = 0; i < vertex_victims.size(); ++ i)
+            graph.deleteVertex(vertex_victims[i]);
+    });
+    return;
+}
+
+/*****************************************************************************************
+ * output
+ *****************************************************************************************/
+
+void printCSV(ostream& os)
+{
+    os << "suite,name,impl,workload,ops,ms,ns_per_op" << endl;
+    for(size_t i = 0; i < results.size(); ++ i)
+    {
+        const BenchResult& r = results[i];
+        os << r.suite << "," << r.name << "," << r.impl << "," << r.workload << "," << r.ops << "," << r.ms << ","
+           << (r.ops > 0 ? r.ms * 1e6 / r.ops : 0.0) << endl;
+    }
+    return;
+}
+
+void printJSON(ostream& os)
+{
+    os << "{\"results\":[";
+    for(size_t i = 0; i < results.size(); ++ i)
+    {
+        const BenchResult& r = results[i];
+        os << (i == 0 ? "\n" : ",\n");
+        os << "{\"suite\":\"" << r.suite << "\",\"name\":\"" << r.name << "\",\"impl\":\"" << r.impl << "\",\"workload\":\"" << r.workload
+           << "\",\"ops\":" << r.ops << ",\"ms\":" << r.ms << ",\"ns_per_op\":" << (r.ops > 0 ? r.ms * 1e6 / r.ops : 0.0) << "}";
+    }
+    os << "\n]}" << endl;
+    return;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc > 3 || (argc == 3 && string(argv[2]) != "csv" && string(argv[2]) != "json"))
+    {
+        cout << "Usage: " << argv[0] << " [max_edges (default 1000000)] [csv|json]" << endl;
+        cout << "Progress goes to stderr, results to stdout." << endl;
+        exit(1);
+    }
+    size_t max_edges = (argc >= 2 ? stoull(argv[1]) : 1000000);
+    bool json = (argc == 3 && string(argv[2]) == "json");
+
+    const size_t container_ops = 1 << 20;
+    benchVector(container_ops);
+    benchList(container_ops);
+    benchQueueStack(container_ops, 16);
+    benchQueueStack(container_ops, 4096);
+    benchHashTable(container_ops / 4, 0.1);
+    benchHashTable(container_ops / 4, 0.25);
+    benchHashTable(container_ops / 4, 0.45);
+
+    MyVector<BenchGraphType::EdgeRecord> edges;
+    for(size_t m = 1000; m <= max_edges; m *= 10)
+    {
+        size_t n = erdosRenyi(edges, m, 42);
+        benchGraph("erdos_renyi", n, edges);
+        n = rmat(edges, m, 42);
+        benchGraph("rmat", n, edges);
+        n = grid(edges, m, 42);
+        benchGraph("grid", n, edges);
+    }
+
+    if(json)
+        printJSON(cout);
+    else
+        printCSV(cout);
+    return 0;
+}
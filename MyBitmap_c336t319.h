@@ -0,0 +1,101 @@
+#ifndef __MYBITMAP_H__
+#define __MYBITMAP_H__
+
+#include <cstdlib>
+
+#include "MyVector_c336t319.h"
+
+// fixed-size bitmap over the dense indices 0, 1, ..., n-1 (one bit per index, packed into 64-bit words)
+class MyBitmap
+{
+  private:
+    size_t theSize;                         // the number of bits
+    MyVector<unsigned long long> words;     // the bits; bit i lives in words[i / 64]
+
+    static const size_t WORD_BITS = 64;
+
+  public:
+
+    // default constructor; creates n cleared bits
+    explicit MyBitmap(const size_t n = 0) :
+        theSize(0),
+        words(0)
+    {
+        resize(n);
+    }
+
+    // changes the number of bits to n and clears all of them
+    void resize(const size_t n)
+    {
+        theSize = n;
+        words.resize((n + WORD_BITS - 1) / WORD_BITS);
+        clear();
+        return;
+    }
+
+    // clears all bits
+    void clear()
+    {
+        for(size_t i = 0; i < words.size(); ++ i)
+        {
+            words[i] = 0;
+        }
+        return;
+    }
+
+    // sets bit i
+    void set(const size_t i)
+    {
+        words[i / WORD_BITS] |= (1ULL << (i % WORD_BITS));
+    }
+
+    // clears bit i
+    void reset(const size_t i)
+    {
+        words[i / WORD_BITS] &= ~(1ULL << (i % WORD_BITS));
+    }
+
+    // checks whether bit i is set
+    bool test(const size_t i) const
+    {
+        return (words[i / WORD_BITS] >> (i % WORD_BITS)) & 1ULL;
+    }
+
+    // returns the number of set bits
+    size_t count() const
+    {
+        size_t cnt = 0;
+        for(size_t i = 0; i < words.size(); ++ i)
+        {
+            cnt += __builtin_popcountll(words[i]);
+        }
+        return cnt;
+    }
+
+    // returns the number of bits
+    size_t size() const
+    {
+        return theSize;
+    }
+
+    // returns the number of 64-bit words backing the bitmap
+    size_t numWords() const
+    {
+        return words.size();
+    }
+
+    // returns word w of the bitmap (bits 64 * w to 64 * w + 63)
+    unsigned long long word(const size_t w) const
+    {
+        return words[w];
+    }
+
+    // returns the heap bytes of the words
+    size_t memoryUsage() const
+    {
+        return words.memoryUsage();
+    }
+
+};
+
+#endif // __MYBITMAP_H__
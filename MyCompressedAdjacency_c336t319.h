@@ -0,0 +1,401 @@
+#ifndef __MYCOMPRESSEDADJACENCY_H__
+#define __MYCOMPRESSEDADJACENCY_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "MyVector_c336t319.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MYGRAPH_HAVE_SSSE3_DECODE 1
+#else
+#define MYGRAPH_HAVE_SSSE3_DECODE 0
+#endif
+
+// read-only adjacency of n vertices, compressed to about 1-2 bytes per entry
+// every list holds the sorted neighbour positions of one vertex (a self-loop appears twice, as in the CSR it is built from)
+// encoding of a list of d neighbours w0 <= w1 <= ... of the vertex u:
+//   the first neighbour as a zigzag varint of w0 - u (small after MyGraph::reorder),
+//   then the d - 1 gaps w[i] - w[i-1] in StreamVByte layout (Lemire et al.): one control byte per group of four gaps
+//   (two bits each: the gap's byte length minus one), followed by the gaps' little-endian bytes
+// full groups are decoded with one SSSE3 shuffle and a prefix sum where the CPU supports it (checked at run time),
+// the last partial group and other CPUs use the scalar decoder
+class MyCompressedAdjacency
+{
+  private:
+    MyVector<uint64_t> block_starts;    // the first byte of every block of BLOCK_VERTICES lists in bytes
+    MyVector<uint32_t> starts;          // the first byte of each list, relative to its block
+    MyVector<uint32_t> degrees;         // the number of entries of each list
+    MyVector<unsigned char> bytes;      // the encoded lists, followed by PADDING zero bytes for the 16-byte loads
+    size_t max_degree;
+
+    static const size_t BLOCK_VERTICES = 64;
+    static const size_t PADDING = 16;
+    static const size_t DECODE_BLOCK = 64;      // the entries forEachNeighbor decodes at a time
+
+  public:
+
+    // default constructor; holds no vertex
+    MyCompressedAdjacency() :
+        block_starts(0),
+        starts(0),
+        degrees(0),
+        bytes(0),
+        max_degree(0)
+    {
+        return;
+    }
+
+    // builds the lists of the CSR adjacency of n vertices: the neighbours of u are nbrs[offsets[u]], ..., nbrs[offsets[u + 1] - 1]
+    // throws std::domain_error if a position does not fit in 32 bits
+    void build(const size_t n, const uint64_t* offsets, const uint64_t* nbrs)
+    {
+        build(n, offsets, nbrs, [](const uint64_t) { return true; });
+        return;
+    }
+
+    // as above, but keeps only the entries k for which keep(k) returns true (e.g. the outgoing ones of a directed graph)
+    template <typename KeepType>
+    void build(const size_t n, const uint64_t* offsets, const uint64_t* nbrs, KeepType keep)
+    {
+        if(n > UINT32_MAX)
+        {
+            throw std::domain_error("MyCompressedAdjacency::build: too many vertices");
+        }
+        // exactly sized (resize would reserve twice the size)
+        MyVector<uint64_t> new_block_starts((n + BLOCK_VERTICES - 1) / BLOCK_VERTICES);
+        MyVector<uint32_t> new_starts(n);
+        MyVector<uint32_t> new_degrees(n);
+        block_starts = std::move(new_block_starts);
+        starts = std::move(new_starts);
+        degrees = std::move(new_degrees);
+        max_degree = 0;
+        MyVector<unsigned char> staging;
+        staging.reserve(offsets[n] * 2 + PADDING);
+        MyVector<uint32_t> list;
+        for(size_t u = 0; u < n; ++ u)
+        {
+            list.resize(0);
+            for(uint64_t k = offsets[u]; k < offsets[u + 1]; ++ k)
+            {
+                if(keep(k))
+                {
+                    list.push_back(static_cast<uint32_t>(nbrs[k]));
+                }
+            }
+            size_t d = list.size();
+            if(d > UINT32_MAX)
+            {
+                throw std::domain_error("MyCompressedAdjacency::build: degree too large");
+            }
+            if(u % BLOCK_VERTICES == 0)
+            {
+                block_starts[u / BLOCK_VERTICES] = staging.size();
+            }
+            if(staging.size() - block_starts[u / BLOCK_VERTICES] > UINT32_MAX)
+            {
+                throw std::domain_error("MyCompressedAdjacency::build: degrees too large");
+            }
+            starts[u] = static_cast<uint32_t>(staging.size() - block_starts[u / BLOCK_VERTICES]);
+            degrees[u] = static_cast<uint32_t>(d);
+            max_degree = std::max(max_degree, d);
+            std::sort(list.begin(), list.end());
+            encodeList(static_cast<uint32_t>(u), list, staging);
+        }
+        for(size_t i = 0; i < PADDING; ++ i)
+        {
+            staging.push_back(0);
+        }
+        // keep exactly the encoded bytes (staging grew geometrically)
+        MyVector<unsigned char> exact(staging.size());
+        std::memcpy(exact.begin(), staging.begin(), staging.size());
+        bytes = std::move(exact);
+        return;
+    }
+
+    // releases the lists
+    void clear()
+    {
+        block_starts.resize(0);
+        starts.resize(0);
+        degrees.resize(0);
+        bytes.resize(0);
+        max_degree = 0;
+        return;
+    }
+
+    // returns the number of vertices
+    size_t numVertices() const
+    {
+        return degrees.size();
+    }
+
+    // returns the number of entries in the list of u
+    size_t degree(const size_t u) const
+    {
+        return degrees[u];
+    }
+
+    // returns the largest degree
+    size_t maxDegree() const
+    {
+        return max_degree;
+    }
+
+    // decodes the list of u into out[0], ..., out[degree(u) - 1] in ascending order
+    void decode(const size_t u, uint32_t* out) const
+    {
+        size_t d = degrees[u];
+        if(d == 0)
+        {
+            return;
+        }
+        const unsigned char* p = listBytes(u);
+        uint32_t prev = firstNeighbor(static_cast<uint32_t>(u), p);
+        out[0] = prev;
+        const unsigned char* ctrl = p;
+        const unsigned char* data = ctrl + numControlBytes(d - 1);
+        decodeGaps(ctrl, data, prev, d - 1, out + 1);
+        return;
+    }
+
+    // calls func(w) for the neighbours w of u in ascending order until it returns false
+    // returns false if func stopped the iteration
+    template <typename FuncType>
+    bool forEachNeighbor(const size_t u, FuncType func) const
+    {
+        size_t d = degrees[u];
+        if(d == 0)
+        {
+            return true;
+        }
+        uint32_t block[DECODE_BLOCK];
+        const unsigned char* p = listBytes(u);
+        uint32_t prev = firstNeighbor(static_cast<uint32_t>(u), p);
+        if(!func(prev))
+        {
+            return false;
+        }
+        const unsigned char* ctrl = p;
+        const unsigned char* data = ctrl + numControlBytes(d - 1);
+        // blocks are multiples of four gaps, so only the last one may end in a partial group
+        for(size_t left = d - 1; left > 0; )
+        {
+            size_t count = (left < DECODE_BLOCK ? left : DECODE_BLOCK);
+            decodeGaps(ctrl, data, prev, count, block);
+            for(size_t i = 0; i < count; ++ i)
+            {
+                if(!func(block[i]))
+                {
+                    return false;
+                }
+            }
+            left -= count;
+        }
+        return true;
+    }
+
+    // returns the bytes used by the lists and their index
+    size_t memoryUsage() const
+    {
+        return block_starts.memoryUsage() + starts.memoryUsage() + degrees.memoryUsage() + bytes.memoryUsage();
+    }
+
+    // returns whether full groups are decoded with SSSE3 on this CPU
+    static bool simdDecode()
+    {
+#if MYGRAPH_HAVE_SSSE3_DECODE
+        static const bool supported = __builtin_cpu_supports("ssse3");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+  private:
+
+    // returns the first byte of the list of u
+    const unsigned char* listBytes(const size_t u) const
+    {
+        return &bytes[block_starts[u / BLOCK_VERTICES] + starts[u]];
+    }
+
+    // returns the number of control bytes for count gaps
+    static size_t numControlBytes(const size_t count)
+    {
+        return (count + 3) / 4;
+    }
+
+    // appends the encoding of the sorted list of u to out
+    static void encodeList(const uint32_t u, const MyVector<uint32_t>& list, MyVector<unsigned char>& out)
+    {
+        if(list.empty())
+        {
+            return;
+        }
+        // zigzag: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+        int64_t diff = static_cast<int64_t>(list[0]) - static_cast<int64_t>(u);
+        uint64_t zz = (diff >= 0 ? static_cast<uint64_t>(diff) << 1 : (static_cast<uint64_t>(-diff) << 1) - 1);
+        while(zz >= 0x80)
+        {
+            out.push_back(static_cast<unsigned char>(zz | 0x80));
+            zz >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(zz));
+
+        size_t count = list.size() - 1;
+        size_t ctrl = out.size();
+        for(size_t i = 0; i < numControlBytes(count); ++ i)
+        {
+            out.push_back(0);
+        }
+        for(size_t i = 0; i < count; ++ i)
+        {
+            uint32_t gap = list[i + 1] - list[i];
+            size_t len = (gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4);
+            out[ctrl + i / 4] |= static_cast<unsigned char>((len - 1) << (2 * (i % 4)));
+            for(size_t b = 0; b < len; ++ b)
+            {
+                out.push_back(static_cast<unsigned char>(gap >> (8 * b)));
+            }
+        }
+        return;
+    }
+
+    // decodes the first neighbour of u at p and advances p past it
+    static uint32_t firstNeighbor(const uint32_t u, const unsigned char*& p)
+    {
+        uint64_t zz = 0;
+        for(unsigned shift = 0; ; shift += 7)
+        {
+            unsigned char c = *p ++;
+            zz |= static_cast<uint64_t>(c & 0x7f) << shift;
+            if(c < 0x80)
+            {
+                break;
+            }
+        }
+        int64_t diff = ((zz & 1) ? -static_cast<int64_t>((zz + 1) >> 1) : static_cast<int64_t>(zz >> 1));
+        return static_cast<uint32_t>(static_cast<int64_t>(u) + diff);
+    }
+
+    // decodes count gaps (a multiple of four unless it ends the list) into the running sums out[0], ..., out[count - 1]
+    // advances ctrl and data, and leaves the last sum in prev
+    static void decodeGaps(const unsigned char*& ctrl, const unsigned char*& data, uint32_t& prev, const size_t count, uint32_t* out)
+    {
+        size_t full = count / 4;
+#if MYGRAPH_HAVE_SSSE3_DECODE
+        if(simdDecode())
+        {
+            decodeGroupsSSSE3(ctrl, data, prev, full, out);
+        }
+        else
+#endif
+        {
+            decodeGroupsScalar(ctrl, data, prev, full, out);
+        }
+        size_t rest = count % 4;
+        if(rest > 0)
+        {
+            unsigned char c = *ctrl ++;
+            for(size_t i = 0; i < rest; ++ i)
+            {
+                size_t len = ((c >> (2 * i)) & 3) + 1;
+                uint32_t gap = 0;
+                for(size_t b = 0; b < len; ++ b)
+                {
+                    gap |= static_cast<uint32_t>(data[b]) << (8 * b);
+                }
+                data += len;
+                prev += gap;
+                out[4 * full + i] = prev;
+            }
+        }
+        return;
+    }
+
+    // decodes groups full groups of four gaps one value at a time
+    static void decodeGroupsScalar(const unsigned char*& ctrl, const unsigned char*& data, uint32_t& prev, const size_t groups, uint32_t* out)
+    {
+        for(size_t g = 0; g < groups; ++ g)
+        {
+            unsigned char c = *ctrl ++;
+            for(size_t i = 0; i < 4; ++ i)
+            {
+                size_t len = ((c >> (2 * i)) & 3) + 1;
+                uint32_t gap = 0;
+                for(size_t b = 0; b < len; ++ b)
+                {
+                    gap |= static_cast<uint32_t>(data[b]) << (8 * b);
+                }
+                data += len;
+                prev += gap;
+                *out ++ = prev;
+            }
+        }
+        return;
+    }
+
+#if MYGRAPH_HAVE_SSSE3_DECODE
+    // the pshufb masks that spread the (up to 16) data bytes of a group over four 32-bit lanes, and the group lengths
+    struct ShuffleTable
+    {
+        unsigned char mask[256][16];
+        unsigned char length[256];
+
+        ShuffleTable()
+        {
+            for(size_t c = 0; c < 256; ++ c)
+            {
+                size_t src = 0;
+                for(size_t i = 0; i < 4; ++ i)
+                {
+                    size_t len = ((c >> (2 * i)) & 3) + 1;
+                    for(size_t b = 0; b < 4; ++ b)
+                    {
+                        // 0x80 makes pshufb write a zero byte
+                        mask[c][4 * i + b] = static_cast<unsigned char>(b < len ? src + b : 0x80);
+                    }
+                    src += len;
+                }
+                length[c] = static_cast<unsigned char>(src);
+            }
+        }
+    };
+
+    static const ShuffleTable& shuffleTable()
+    {
+        static const ShuffleTable table;
+        return table;
+    }
+
+    // decodes groups full groups of four gaps with one shuffle and a four-lane prefix sum each
+    // (reads 16 bytes per group; bytes ends in PADDING zero bytes for the last ones)
+    __attribute__((target("ssse3")))
+    static void decodeGroupsSSSE3(const unsigned char*& ctrl, const unsigned char*& data, uint32_t& prev, const size_t groups, uint32_t* out)
+    {
+        const ShuffleTable& table = shuffleTable();
+        __m128i run = _mm_set1_epi32(static_cast<int>(prev));
+        for(size_t g = 0; g < groups; ++ g)
+        {
+            unsigned char c = *ctrl ++;
+            __m128i gaps = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)),
+                                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.mask[c])));
+            data += table.length[c];
+            gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 4));
+            gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 8));
+            run = _mm_add_epi32(gaps, run);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), run);
+            out += 4;
+            run = _mm_shuffle_epi32(run, 0xff);
+        }
+        prev = static_cast<uint32_t>(_mm_cvtsi128_si32(run));
+        return;
+    }
+#endif
+};
+
+#endif // __MYCOMPRESSEDADJACENCY_H__
@@ -0,0 +1,133 @@
+#ifndef __MYDISJOINTSET_H__
+#define __MYDISJOINTSET_H__
+
+#include <utility>
+#include <cstdlib>
+
+#include "MyVector_c336t319.h"
+
+// disjoint-set forest (union-find) over the dense element indices 0, 1, ..., n-1
+// uses union by rank and path compression, so find() and unite() run in amortized O(alpha(n))
+class MyDisjointSet
+{
+  private:
+    MyVector<size_t> parent;        // the parent of each element; a root is its own parent
+    MyVector<unsigned char> rank;   // the upper bound of the height of the tree rooted at each element
+    size_t theNumSets;              // the number of disjoint sets currently held
+
+  public:
+
+    // default constructor; creates n singleton sets
+    explicit MyDisjointSet(const size_t n = 0) :
+        parent(0),
+        rank(0),
+        theNumSets(0)
+    {
+        reset(n);
+    }
+
+    // discards all unions and creates n singleton sets
+    void reset(const size_t n)
+    {
+        parent.resize(0);
+        rank.resize(0);
+        parent.reserve(n);
+        rank.reserve(n);
+        for(size_t i = 0; i < n; ++ i)
+        {
+            parent.push_back(i);
+            rank.push_back(0);
+        }
+        theNumSets = n;
+        return;
+    }
+
+    // appends a new singleton set; returns the index of the new element
+    size_t makeSet()
+    {
+        size_t x = parent.size();
+        parent.push_back(x);
+        rank.push_back(0);
+        ++ theNumSets;
+        return x;
+    }
+
+    // returns the representative of the set containing x
+    // compresses the path from x to the root along the way
+    size_t find(size_t x)
+    {
+        size_t root = x;
+        while(parent[root] != root)
+        {
+            root = parent[root];
+        }
+        while(parent[x] != root)
+        {
+            size_t next = parent[x];
+            parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+    // returns the representative of the set containing x without compressing the path
+    // reads only, so it may run on several threads at once while no thread unites
+    size_t root(size_t x) const
+    {
+        while(parent[x] != x)
+        {
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // merges the sets containing a and b
+    // returns true if they were different sets, false otherwise
+    bool unite(const size_t a, const size_t b)
+    {
+        size_t ra = find(a);
+        size_t rb = find(b);
+        if(ra == rb)
+        {
+            return false;
+        }
+        if(rank[ra] < rank[rb])
+        {
+            std::swap(ra, rb);
+        }
+        parent[rb] = ra;
+        if(rank[ra] == rank[rb])
+        {
+            ++ rank[ra];
+        }
+        -- theNumSets;
+        return true;
+    }
+
+    // checks whether a and b belong to the same set
+    bool connected(const size_t a, const size_t b)
+    {
+        return find(a) == find(b);
+    }
+
+    // returns the number of elements
+    size_t size() const
+    {
+        return parent.size();
+    }
+
+    // returns the number of disjoint sets
+    size_t numSets() const
+    {
+        return theNumSets;
+    }
+
+    // returns the heap bytes of the parent and rank arrays
+    size_t memoryUsage() const
+    {
+        return parent.memoryUsage() + rank.memoryUsage();
+    }
+
+};
+
+#endif // __MYDISJOINTSET_H__
@@ -0,0 +1,479 @@
+#ifndef __MYGRAPHCOLUMNS_H__
+#define __MYGRAPHCOLUMNS_H__
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "MyGraph_Template.h"
+#include "MyIDMap_c336t319.h"
+#include "MyVector_c336t319.h"
+
+// columnar (struct-of-arrays) copy of the vertices and edges of a MyGraph
+// every field lives in its own contiguous column: the IDs, the tags, the end positions of the edges (the topology)
+// and the vertex and edge properties; a scan reads only the columns it needs, front to back, instead of
+// following one pointer per element into objects that hold all the fields
+// row i of the vertex columns is the vertex at vertex_set position i when build was called, and row j of the
+// edge columns the edge at edge_set position j; the end positions index the vertex rows
+// the columns are a copy: they do not follow later changes of the graph (build again, O(n + m))
+// the scan, filter and aggregate functions are written as plain counted loops over the columns with
+// independent accumulators, so over arithmetic properties the compiler turns them into vector loops
+template <typename VertexDataType, typename EdgeDataType, typename GraphPolicy>
+class MyGraphColumns
+{
+  public:
+    typedef MyGraph<VertexDataType, EdgeDataType, GraphPolicy> GraphType;     // the graph type the columns are taken from
+
+    // one vertex seen through the columns (the fields of MyGraph::Vertex)
+    class VertexView
+    {
+      public:
+        VertexView(const VertexIDType vid, const int vtag, const VertexDataType& vdata) :
+            id(vid),
+            tag(vtag),
+            data(vdata)
+        {
+            return;
+        }
+
+        VertexIDType id;                // the unique ID of the vertex
+        int tag;                        // the reserved tag variable
+        const VertexDataType& data;     // the property of the vertex (a reference into the data column)
+    };
+
+    // one edge seen through the columns (the fields of MyGraph::Edge)
+    class EdgeView
+    {
+      public:
+        EdgeView(const EdgeIDType eid, const VertexIDType sid, const VertexIDType tid, const int etag, const EdgeDataType& edata) :
+            id(eid),
+            src(sid),
+            tgt(tid),
+            tag(etag),
+            data(edata)
+        {
+            return;
+        }
+
+        EdgeIDType id;                  // the unique ID of the edge
+        VertexIDType src, tgt;          // the IDs of the source vertex and the target vertex of the edge
+        int tag;                        // the reserved tag variable
+        const EdgeDataType& data;       // the property of the edge (a reference into the data column)
+    };
+
+    // default constructor; holds no rows
+    MyGraphColumns()
+    {
+        return;
+    }
+
+    // copies the vertices and edges of graph into the columns
+    explicit MyGraphColumns(const GraphType& graph)
+    {
+        build(graph);
+    }
+
+    // replaces the columns with the vertices and edges of graph, in vertex_set and edge_set order
+    // expected time complexity: O(n + m); every column is allocated once at its exact size
+    // throws std::out_of_range if an edge end vertex is not in the graph (the columns are left unchanged)
+    void build(const GraphType& graph)
+    {
+        MYGRAPH_SPAN("MyGraphColumns", "build");
+        size_t n = graph.vertex_set.size();
+        size_t m = graph.edge_set.size();
+        MyVector<VertexIDType> new_vertex_ids(n);
+        MyVector<int> new_vertex_tags(n);
+        MyVector<VertexDataType> new_vertex_data(n);
+        for(size_t i = 0; i < n; ++ i)
+        {
+            const typename GraphType::Vertex* v = graph.vertex_set[i];
+            new_vertex_ids[i] = v->id;
+            new_vertex_tags[i] = v->tag;
+            new_vertex_data[i] = v->data;
+        }
+        MyVector<EdgeIDType> new_edge_ids(m);
+        MyVector<size_t> new_edge_src(m);
+        MyVector<size_t> new_edge_tgt(m);
+        MyVector<int> new_edge_tags(m);
+        MyVector<EdgeDataType> new_edge_data(m);
+        for(size_t j = 0; j < m; ++ j)
+        {
+            const typename GraphType::Edge* e = graph.edge_set[j];
+            new_edge_ids[j] = e->id;
+            if(!graph.vertex_map.get(e->src, new_edge_src[j]) || !graph.vertex_map.get(e->tgt, new_edge_tgt[j]))
+            {
+                throw std::out_of_range("MyGraphColumns build: edge end vertex not found");
+            }
+            new_edge_tags[j] = e->tag;
+            new_edge_data[j] = e->data;
+        }
+        vertex_ids = std::move(new_vertex_ids);
+        vertex_tags = std::move(new_vertex_tags);
+        vertex_data = std::move(new_vertex_data);
+        edge_ids = std::move(new_edge_ids);
+        edge_src = std::move(new_edge_src);
+        edge_tgt = std::move(new_edge_tgt);
+        edge_tags = std::move(new_edge_tags);
+        edge_data = std::move(new_edge_data);
+        vertex_map = graph.vertex_map;
+        edge_map = graph.edge_map;
+        return;
+    }
+
+    // releases every column
+    void clear()
+    {
+        vertex_ids = MyVector<VertexIDType>();
+        vertex_tags = MyVector<int>();
+        vertex_data = MyVector<VertexDataType>();
+        edge_ids = MyVector<EdgeIDType>();
+        edge_src = MyVector<size_t>();
+        edge_tgt = MyVector<size_t>();
+        edge_tags = MyVector<int>();
+        edge_data = MyVector<EdgeDataType>();
+        vertex_map.clear();
+        edge_map.clear();
+        return;
+    }
+
+    // returns the number of vertex rows
+    size_t numVertices(void) const
+    {
+        return vertex_ids.size();
+    }
+
+    // returns the number of edge rows
+    size_t numEdges(void) const
+    {
+        return edge_ids.size();
+    }
+
+    // returns the vertex vid as a view of its row
+    // throws std::out_of_range if vid has no row
+    VertexView getVertex(const VertexIDType vid) const
+    {
+        size_t pos = vertexRow(vid);
+        return VertexView(vertex_ids[pos], vertex_tags[pos], vertex_data[pos]);
+    }
+
+    // returns the edge eid as a view of its row
+    // throws std::out_of_range if eid has no row
+    EdgeView getEdge(const EdgeIDType eid) const
+    {
+        size_t pos = edgeRow(eid);
+        return EdgeView(edge_ids[pos], vertex_ids[edge_src[pos]], vertex_ids[edge_tgt[pos]], edge_tags[pos], edge_data[pos]);
+    }
+
+    // returns the row of the vertex vid
+    // throws std::out_of_range if vid has no row
+    size_t vertexRow(const VertexIDType vid) const
+    {
+        size_t pos;
+        if(!vertex_map.get(vid, pos))
+        {
+            throw std::out_of_range("MyGraphColumns vertexRow: vertex ID not found");
+        }
+        return pos;
+    }
+
+    // returns the row of the edge eid
+    // throws std::out_of_range if eid has no row
+    size_t edgeRow(const EdgeIDType eid) const
+    {
+        size_t pos;
+        if(!edge_map.get(eid, pos))
+        {
+            throw std::out_of_range("MyGraphColumns edgeRow: edge ID not found");
+        }
+        return pos;
+    }
+
+    // the columns; row i of every vertex column (and row j of every edge column) belongs to the same element
+    const MyVector<VertexIDType>& vertexIDs(void) const
+    {
+        return vertex_ids;
+    }
+
+    const MyVector<int>& vertexTags(void) const
+    {
+        return vertex_tags;
+    }
+
+    const MyVector<VertexDataType>& vertexData(void) const
+    {
+        return vertex_data;
+    }
+
+    const MyVector<EdgeIDType>& edgeIDs(void) const
+    {
+        return edge_ids;
+    }
+
+    // the vertex rows of the source ends of the edges
+    const MyVector<size_t>& edgeSources(void) const
+    {
+        return edge_src;
+    }
+
+    // the vertex rows of the target ends of the edges
+    const MyVector<size_t>& edgeTargets(void) const
+    {
+        return edge_tgt;
+    }
+
+    const MyVector<int>& edgeTags(void) const
+    {
+        return edge_tags;
+    }
+
+    const MyVector<EdgeDataType>& edgeData(void) const
+    {
+        return edge_data;
+    }
+
+    // returns the number of vertices whose property satisfies pred (a bool function of const VertexDataType&)
+    template <typename PredType>
+    size_t countVertices(PredType pred) const
+    {
+        return countRows(vertex_data, pred);
+    }
+
+    // returns the number of edges whose property satisfies pred (a bool function of const EdgeDataType&)
+    template <typename PredType>
+    size_t countEdges(PredType pred) const
+    {
+        return countRows(edge_data, pred);
+    }
+
+    // fills vids with the IDs of the vertices whose property satisfies pred, in row order
+    template <typename PredType>
+    void filterVertices(PredType pred, MyVector<VertexIDType>& vids) const
+    {
+        filterRows(vertex_data, vertex_ids, pred, vids);
+        return;
+    }
+
+    // fills eids with the IDs of the edges whose property satisfies pred, in row order
+    template <typename PredType>
+    void filterEdges(PredType pred, MyVector<EdgeIDType>& eids) const
+    {
+        filterRows(edge_data, edge_ids, pred, eids);
+        return;
+    }
+
+    // returns the sum of func(data) over all vertices (func maps const VertexDataType& to something addable to SumType)
+    // the terms are added in SCAN_LANES interleaved partial sums, so a floating-point result may differ
+    // in the last bits from a sum in row order
+    template <typename SumType, typename FuncType>
+    SumType sumVertices(FuncType func) const
+    {
+        return sumRows<SumType>(vertex_data, func);
+    }
+
+    // returns the sum of func(data) over all edges (see sumVertices)
+    template <typename SumType, typename FuncType>
+    SumType sumEdges(FuncType func) const
+    {
+        return sumRows<SumType>(edge_data, func);
+    }
+
+    // returns the sum of the vertex properties, added up as SumType
+    template <typename SumType>
+    SumType sumVertexData(void) const
+    {
+        return sumRows<SumType>(vertex_data, Identity<VertexDataType>());
+    }
+
+    // returns the sum of the edge properties, added up as SumType
+    template <typename SumType>
+    SumType sumEdgeData(void) const
+    {
+        return sumRows<SumType>(edge_data, Identity<EdgeDataType>());
+    }
+
+    // stores the smallest and the largest edge property (by operator<) in min_data and max_data
+    // returns false (and leaves both unchanged) if there is no edge
+    bool edgeDataRange(EdgeDataType& min_data, EdgeDataType& max_data) const
+    {
+        return rangeOfRows(edge_data, min_data, max_data);
+    }
+
+    // stores the smallest and the largest vertex property (by operator<) in min_data and max_data
+    // returns false (and leaves both unchanged) if there is no vertex
+    bool vertexDataRange(VertexDataType& min_data, VertexDataType& max_data) const
+    {
+        return rangeOfRows(vertex_data, min_data, max_data);
+    }
+
+    // fills sums (one entry per vertex row) with the sum of func(data) over the edges incident to each vertex,
+    // e.g. the weighted degree; a self-loop is counted twice, as in MyGraph::degree
+    template <typename SumType, typename FuncType>
+    void sumIncidentEdges(FuncType func, MyVector<SumType>& sums) const
+    {
+        size_t n = vertex_ids.size();
+        size_t m = edge_ids.size();
+        MyVector<SumType> out(n);
+        for(size_t i = 0; i < n; ++ i)
+        {
+            out[i] = SumType();
+        }
+        for(size_t j = 0; j < m; ++ j)
+        {
+            SumType term = func(edge_data[j]);
+            out[edge_src[j]] += term;
+            out[edge_tgt[j]] += term;
+        }
+        sums = std::move(out);
+        return;
+    }
+
+    // returns the bytes held by the columns and the ID maps (not counting memory owned by the properties)
+    size_t memoryUsage(void) const
+    {
+        return sizeof(*this) + vertex_ids.memoryUsage() + vertex_tags.memoryUsage() + vertex_data.memoryUsage()
+               + edge_ids.memoryUsage() + edge_src.memoryUsage() + edge_tgt.memoryUsage() + edge_tags.memoryUsage()
+               + edge_data.memoryUsage() + vertex_map.memoryUsage() + edge_map.memoryUsage();
+    }
+
+  private:
+
+    static const size_t SCAN_LANES = 8;     // the independent accumulators of sumRows (a multiple of every vector width)
+
+    MyVector<VertexIDType> vertex_ids;      // the vertex IDs
+    MyVector<int> vertex_tags;              // the vertex tags
+    MyVector<VertexDataType> vertex_data;   // the vertex properties
+    MyVector<EdgeIDType> edge_ids;          // the edge IDs
+    MyVector<size_t> edge_src;              // the vertex rows of the source ends
+    MyVector<size_t> edge_tgt;              // the vertex rows of the target ends
+    MyVector<int> edge_tags;                // the edge tags
+    MyVector<EdgeDataType> edge_data;       // the edge properties
+    MyIDMap vertex_map;                     // the mapping between a vertex ID and its row
+    MyIDMap edge_map;                       // the mapping between an edge ID and its row
+
+    // returns its argument (the term of sumVertexData and sumEdgeData)
+    template <typename DataType>
+    struct Identity
+    {
+        const DataType& operator()(const DataType& x) const
+        {
+            return x;
+        }
+    };
+
+    // counts the rows of column that satisfy pred, without a branch per row
+    template <typename DataType, typename PredType>
+    static size_t countRows(const MyVector<DataType>& column, PredType pred)
+    {
+        size_t n = column.size();
+        size_t cnt = 0;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            cnt += (pred(column[i]) ? 1 : 0);
+        }
+        return cnt;
+    }
+
+    // fills out with ids[i] for every row i of column that satisfies pred
+    // every ID is written and the output position advanced by the predicate, so there is no branch per row
+    template <typename DataType, typename IDType, typename PredType>
+    static void filterRows(const MyVector<DataType>& column, const MyVector<IDType>& ids, PredType pred, MyVector<IDType>& out)
+    {
+        size_t n = column.size();
+        MyVector<IDType> matched(n);
+        size_t k = 0;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            matched[k] = ids[i];
+            k += (pred(column[i]) ? 1 : 0);
+        }
+        matched.resize(k);
+        out = std::move(matched);
+        return;
+    }
+
+    // adds up func(column[i]) over all rows in SCAN_LANES partial sums
+    // the partial sums do not depend on each other, so the loop body maps onto vector registers
+    template <typename SumType, typename DataType, typename FuncType>
+    static SumType sumRows(const MyVector<DataType>& column, FuncType func)
+    {
+        size_t n = column.size();
+        SumType lanes[SCAN_LANES];
+        for(size_t l = 0; l < SCAN_LANES; ++ l)
+        {
+            lanes[l] = SumType();
+        }
+        size_t i = 0;
+        for(; i + SCAN_LANES <= n; i += SCAN_LANES)
+        {
+            for(size_t l = 0; l < SCAN_LANES; ++ l)
+            {
+                lanes[l] += func(column[i + l]);
+            }
+        }
+        for(; i < n; ++ i)
+        {
+            lanes[0] += func(column[i]);
+        }
+        SumType sum = lanes[0];
+        for(size_t l = 1; l < SCAN_LANES; ++ l)
+        {
+            sum += lanes[l];
+        }
+        return sum;
+    }
+
+    // finds the smallest and the largest entry of column in one pass
+    // returns false if the column is empty
+    template <typename DataType>
+    static bool rangeOfRows(const MyVector<DataType>& column, DataType& min_data, DataType& max_data)
+    {
+        if(column.size() == 0)
+        {
+            return false;
+        }
+        rangeOfRows(column, min_data, max_data, std::is_arithmetic<DataType>());
+        return true;
+    }
+
+    // arithmetic entries: running minimum and maximum by value (compiles to vector min/max)
+    template <typename DataType>
+    static void rangeOfRows(const MyVector<DataType>& column, DataType& min_data, DataType& max_data, std::true_type)
+    {
+        size_t n = column.size();
+        DataType lo = column[0];
+        DataType hi = column[0];
+        for(size_t i = 1; i < n; ++ i)
+        {
+            lo = (column[i] < lo ? column[i] : lo);
+            hi = (hi < column[i] ? column[i] : hi);
+        }
+        min_data = lo;
+        max_data = hi;
+        return;
+    }
+
+    // other entries: running positions, so nothing is copied until the end
+    template <typename DataType>
+    static void rangeOfRows(const MyVector<DataType>& column, DataType& min_data, DataType& max_data, std::false_type)
+    {
+        size_t n = column.size();
+        size_t min_pos = 0;
+        size_t max_pos = 0;
+        for(size_t i = 1; i < n; ++ i)
+        {
+            if(column[i] < column[min_pos])
+            {
+                min_pos = i;
+            }
+            if(column[max_pos] < column[i])
+            {
+                max_pos = i;
+            }
+        }
+        min_data = column[min_pos];
+        max_data = column[max_pos];
+        return;
+    }
+};
+
+#endif // __MYGRAPHCOLUMNS_H__
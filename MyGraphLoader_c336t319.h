@@ -0,0 +1,440 @@
+#ifndef __MYGRAPHLOADER_H__
+#define __MYGRAPHLOADER_H__
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "MyGraph_Template.h"
+#include "MyVector_c336t319.h"
+#include "MyHashTable_c336t319.h"
+#include "MyThreadPool_c336t319.h"
+#include "MyMappedFile_c336t319.h"
+
+// the name -> vertex ID index of a loaded graph
+// split into shards by a hash of the name, so the shards can be built in parallel;
+// read-only after build(), so any number of threads may call get() at once
+class MyNameIndex
+{
+  private:
+    MyVector<MyHashTable<std::string, VertexIDType>* > shards;
+    size_t theSize;
+
+    // FNV-1a over the name; independent of the hash used inside the shards
+    static size_t shardOf(const char* s, const size_t len, const size_t num_shards)
+    {
+        unsigned long long h = 14695981039346656037ULL;
+        for(size_t i = 0; i < len; ++ i)
+        {
+            h = (h ^ static_cast<unsigned char>(s[i])) * 1099511628211ULL;
+        }
+        return static_cast<size_t>(h % num_shards);
+    }
+
+    void release()
+    {
+        for(size_t i = 0; i < shards.size(); ++ i)
+        {
+            delete shards[i];
+        }
+        shards.resize(0);
+        theSize = 0;
+        return;
+    }
+
+  public:
+
+    static const size_t NUM_SHARDS = 64;
+
+    // default constructor; creates an empty index
+    MyNameIndex() :
+        shards(0),
+        theSize(0)
+    {
+        return;
+    }
+
+    // destructor
+    ~MyNameIndex()
+    {
+        release();
+    }
+
+    MyNameIndex(const MyNameIndex&) = delete;
+    MyNameIndex& operator=(const MyNameIndex&) = delete;
+
+    // replaces the index with names[i] -> first_id + i
+    // if a name occurs more than once, its first occurrence wins
+    void build(const MyVector<std::string>& names, const VertexIDType first_id, MyThreadPool& pool)
+    {
+        release();
+        shards.resize(NUM_SHARDS);
+        for(size_t s = 0; s < NUM_SHARDS; ++ s)
+        {
+            shards[s] = new MyHashTable<std::string, VertexIDType>;
+        }
+
+        // bucket the names by shard with a counting sort in fixed chunks: every chunk counts its names per shard,
+        // a prefix sum over (shard, chunk) gives each chunk its place in every bucket, and the chunks scatter their
+        // name indices; a bucket keeps the names in file order, so each thread then fills whole shards from its buckets
+        // alone (no two threads share a table)
+        const size_t BUILD_CHUNK = 4096;
+        size_t n = names.size();
+        size_t num_chunks = (n + BUILD_CHUNK - 1) / BUILD_CHUNK;
+        MyVector<unsigned char> shard_of(n);
+        MyVector<size_t> place(num_chunks * NUM_SHARDS);     // place[c * NUM_SHARDS + s]: the names of chunk c in shard s
+        // a pool without workers hands out the whole range at once; it is split the same way
+        pool.parallelFor(0, n, BUILD_CHUNK, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t c = lo; c < hi; c += BUILD_CHUNK)
+            {
+                size_t* count = &place[(c / BUILD_CHUNK) * NUM_SHARDS];
+                for(size_t s = 0; s < NUM_SHARDS; ++ s)
+                {
+                    count[s] = 0;
+                }
+                for(size_t i = c; i < std::min(hi, c + BUILD_CHUNK); ++ i)
+                {
+                    shard_of[i] = static_cast<unsigned char>(shardOf(names[i].data(), names[i].size(), NUM_SHARDS));
+                    ++ count[shard_of[i]];
+                }
+            }
+        });
+        MyVector<size_t> bucket(NUM_SHARDS + 1);    // bucket s is order[bucket[s]], ..., order[bucket[s + 1] - 1]
+        size_t total = 0;
+        for(size_t s = 0; s < NUM_SHARDS; ++ s)
+        {
+            bucket[s] = total;
+            for(size_t c = 0; c < num_chunks; ++ c)
+            {
+                size_t count = place[c * NUM_SHARDS + s];
+                place[c * NUM_SHARDS + s] = total;
+                total += count;
+            }
+        }
+        bucket[NUM_SHARDS] = total;
+        MyVector<size_t> order(n);
+        pool.parallelFor(0, n, BUILD_CHUNK, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t c = lo; c < hi; c += BUILD_CHUNK)
+            {
+                size_t* next = &place[(c / BUILD_CHUNK) * NUM_SHARDS];
+                for(size_t i = c; i < std::min(hi, c + BUILD_CHUNK); ++ i)
+                {
+                    order[next[shard_of[i]] ++] = i;
+                }
+            }
+        });
+        pool.parallelFor(0, NUM_SHARDS, 1, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t s = lo; s < hi; ++ s)
+            {
+                shards[s]->reserve(bucket[s + 1] - bucket[s]);
+                for(size_t k = bucket[s]; k < bucket[s + 1]; ++ k)
+                {
+                    size_t i = order[k];
+                    shards[s]->insert(HashedObj<std::string, VertexIDType>(names[i], first_id + static_cast<VertexIDType>(i)));
+                }
+            }
+        });
+        for(size_t s = 0; s < NUM_SHARDS; ++ s)
+        {
+            theSize += shards[s]->size();
+        }
+        return;
+    }
+
+    // retrieves the vertex ID of name
+    // returns false if the name is not indexed
+    bool get(const std::string& name, VertexIDType& vid) const
+    {
+        if(shards.empty())
+        {
+            return false;
+        }
+        return shards[shardOf(name.data(), name.size(), NUM_SHARDS)]->get(name, vid);
+    }
+
+    // returns the number of distinct names
+    size_t size() const
+    {
+        return theSize;
+    }
+
+};
+
+// parallel loader of the vertex file (one vertex name per line) and the edge file
+// (one "name1 name2 value" per line, separated by spaces or tabs) into a MyGraph<std::string, EdgeDataType>
+// the files are mapped, cut into chunks at line boundaries, and the chunks are parsed on the pool's threads
+// with a hand-written tokenizer; the records are then handed to addVertices/addEdges in file order,
+// so vertices and edges get the same IDs as when added one by one
+// empty lines are skipped; a trailing '\r' is dropped from every line
+template <typename EdgeDataType>
+class MyGraphLoader
+{
+  public:
+    typedef MyGraph<std::string, EdgeDataType> GraphType;
+    typedef typename GraphType::EdgeRecord EdgeRecordType;
+
+    // loads the vertex file at path, adds the vertices in file order and indexes their names
+    // names receives the vertex names in file order
+    // returns false if the file cannot be opened
+    static bool loadVertices(const std::string& path, GraphType& graph, MyVector<std::string>& names, MyNameIndex& index, MyThreadPool& pool)
+    {
+        MyMappedFile file;
+        if(!file.open(path))
+        {
+            return false;
+        }
+        MyVector<size_t> bounds;
+        splitLines(file.data(), file.size(), pool.numThreads(), bounds);
+        size_t num_chunks = bounds.size() - 1;
+
+        MyVector<MyVector<std::string> > chunk_names(num_chunks);
+        pool.parallelFor(0, num_chunks, 1, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t c = lo; c < hi; ++ c)
+            {
+                const char* p = file.data() + bounds[c];
+                const char* end = file.data() + bounds[c + 1];
+                while(p < end)
+                {
+                    const char* eol = lineEnd(p, end);
+                    const char* last = trimCR(p, eol);
+                    if(last > p)
+                    {
+                        chunk_names[c].push_back(std::string(p, last - p));
+                    }
+                    p = eol + 1;
+                }
+            }
+        });
+
+        size_t total = 0;
+        for(size_t c = 0; c < num_chunks; ++ c)
+        {
+            total += chunk_names[c].size();
+        }
+        names.resize(0);
+        names.reserve(total);
+        for(size_t c = 0; c < num_chunks; ++ c)
+        {
+            for(size_t i = 0; i < chunk_names[c].size(); ++ i)
+            {
+                names.push_back(std::move(chunk_names[c][i]));
+            }
+        }
+        VertexIDType first_id = graph.addVertices(names);
+        index.build(names, first_id, pool);
+        return true;
+    }
+
+    // loads the edge file at path and adds the edges in file order
+    // the endpoint names are resolved through index (see loadVertices)
+    // returns false if the file cannot be opened
+    // throws std::domain_error (before adding any edge) on a malformed line or an unknown name
+    static bool loadEdges(const std::string& path, GraphType& graph, const MyNameIndex& index, MyThreadPool& pool)
+    {
+        MyMappedFile file;
+        if(!file.open(path))
+        {
+            return false;
+        }
+        MyVector<size_t> bounds;
+        splitLines(file.data(), file.size(), pool.numThreads(), bounds);
+        size_t num_chunks = bounds.size() - 1;
+
+        // jobs on the pool must not throw, so every chunk reports its first bad line instead
+        MyVector<MyVector<EdgeRecordType> > chunk_edges(num_chunks);
+        MyVector<std::string> chunk_error(num_chunks);
+        pool.parallelFor(0, num_chunks, 1, [&](size_t, size_t lo, size_t hi)
+        {
+            std::string name_1, name_2;     // reused, so resolving a name allocates nothing once they are large enough
+            for(size_t c = lo; c < hi; ++ c)
+            {
+                const char* p = file.data() + bounds[c];
+                const char* end = file.data() + bounds[c + 1];
+                while(p < end && chunk_error[c].empty())
+                {
+                    const char* eol = lineEnd(p, end);
+                    const char* last = trimCR(p, eol);
+                    const char* q = skipBlanks(p, last);
+                    if(q < last)
+                    {
+                        const char* tok_1 = q;
+                        q = skipToken(q, last);
+                        name_1.assign(tok_1, q - tok_1);
+                        q = skipBlanks(q, last);
+                        const char* tok_2 = q;
+                        q = skipToken(q, last);
+                        name_2.assign(tok_2, q - tok_2);
+                        q = skipBlanks(q, last);
+                        const char* tok_3 = q;
+                        q = skipToken(q, last);
+
+                        VertexIDType sid, tid;
+                        EdgeDataType value;
+                        if(name_2.empty() || !parseValue(tok_3, q, value) || skipBlanks(q, last) != last)
+                        {
+                            chunk_error[c] = "MyGraphLoader::loadEdges: malformed line \"" + std::string(p, last - p) + "\".";
+                        }
+                        else if(!index.get(name_1, sid) || !index.get(name_2, tid))
+                        {
+                            chunk_error[c] = "MyGraphLoader::loadEdges: adding edge between nodes that do not exist (line \"" + std::string(p, last - p) + "\").";
+                        }
+                        else
+                        {
+                            chunk_edges[c].push_back(EdgeRecordType(sid, tid, std::move(value)));
+                        }
+                    }
+                    p = eol + 1;
+                }
+            }
+        });
+
+        size_t total = 0;
+        for(size_t c = 0; c < num_chunks; ++ c)
+        {
+            if(!chunk_error[c].empty())
+            {
+                throw std::domain_error(chunk_error[c]);
+            }
+            total += chunk_edges[c].size();
+        }
+        MyVector<EdgeRecordType> edges;
+        edges.reserve(total);
+        for(size_t c = 0; c < num_chunks; ++ c)
+        {
+            for(size_t i = 0; i < chunk_edges[c].size(); ++ i)
+            {
+                edges.push_back(std::move(chunk_edges[c][i]));
+            }
+        }
+        graph.addEdges(std::move(edges));
+        return true;
+    }
+
+  private:
+    static const size_t MIN_CHUNK_BYTES = 1 << 16;      // smaller files are cut into fewer chunks
+
+    // cuts [data, data + size) into about 4 chunks per thread, each ending right after a newline (or at the end)
+    // bounds receives the chunk offsets; chunk c is [bounds[c], bounds[c + 1])
+    static void splitLines(const char* data, const size_t size, const size_t num_threads, MyVector<size_t>& bounds)
+    {
+        size_t num_chunks = std::max<size_t>(1, std::min(4 * num_threads, size / MIN_CHUNK_BYTES));
+        bounds.resize(0);
+        bounds.push_back(0);
+        for(size_t c = 1; c < num_chunks; ++ c)
+        {
+            size_t cut = std::max(size * c / num_chunks, bounds.back());
+            const void* nl = (cut < size ? std::memchr(data + cut, '\n', size - cut) : nullptr);
+            cut = (nl != nullptr ? static_cast<const char*>(nl) - data + 1 : size);
+            if(cut > bounds.back())
+            {
+                bounds.push_back(cut);
+            }
+        }
+        if(bounds.back() < size || bounds.size() == 1)
+        {
+            bounds.push_back(size);
+        }
+        return;
+    }
+
+    // returns the position of the newline ending the line at p (or end)
+    static const char* lineEnd(const char* p, const char* end)
+    {
+        const void* nl = std::memchr(p, '\n', end - p);
+        return (nl != nullptr ? static_cast<const char*>(nl) : end);
+    }
+
+    // drops a trailing '\r' from the line [p, eol)
+    static const char* trimCR(const char* p, const char* eol)
+    {
+        return (eol > p && eol[-1] == '\r' ? eol - 1 : eol);
+    }
+
+    static bool isBlank(const char c)
+    {
+        return c == ' ' || c == '\t';
+    }
+
+    static const char* skipBlanks(const char* p, const char* end)
+    {
+        while(p < end && isBlank(*p))
+        {
+            ++ p;
+        }
+        return p;
+    }
+
+    static const char* skipToken(const char* p, const char* end)
+    {
+        while(p < end && !isBlank(*p))
+        {
+            ++ p;
+        }
+        return p;
+    }
+
+    // parses the integer in [p, end); returns false if it is empty, has other characters, or does not fit
+    template <typename ValueType>
+    static typename std::enable_if<std::is_integral<ValueType>::value, bool>::type parseValue(const char* p, const char* end, ValueType& out)
+    {
+        bool negative = false;
+        if(p < end && (*p == '-' || *p == '+'))
+        {
+            negative = (*p == '-');
+            ++ p;
+        }
+        if(p == end || (negative && !std::is_signed<ValueType>::value))
+        {
+            return false;
+        }
+        unsigned long long v = 0;
+        for(; p < end; ++ p)
+        {
+            if(*p < '0' || *p > '9')
+            {
+                return false;
+            }
+            unsigned long long next = v * 10 + static_cast<unsigned long long>(*p - '0');
+            if(next / 10 != v)
+            {
+                return false;
+            }
+            v = next;
+        }
+        ValueType value = static_cast<ValueType>(negative ? 0 - v : v);
+        if((negative ? 0 - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value)) != v)
+        {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    // parses the floating-point number in [p, end)
+    template <typename ValueType>
+    static typename std::enable_if<std::is_floating_point<ValueType>::value, bool>::type parseValue(const char* p, const char* end, ValueType& out)
+    {
+        if(p == end)
+        {
+            return false;
+        }
+        std::string token(p, end - p);
+        char* stop = nullptr;
+        double v = std::strtod(token.c_str(), &stop);
+        if(stop != token.c_str() + token.size())
+        {
+            return false;
+        }
+        out = static_cast<ValueType>(v);
+        return true;
+    }
+};
+
+#endif // __MYGRAPHLOADER_H__
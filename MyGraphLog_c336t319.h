@@ -0,0 +1,697 @@
+#ifndef __MYGRAPHLOG_H__
+#define __MYGRAPHLOG_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "MyGraph_Template.h"
+#include "MyMappedFile_c336t319.h"
+#include "MySnapshot_c336t319.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define MYGRAPH_HAVE_FSYNC 1
+#else
+#define MYGRAPH_HAVE_FSYNC 0
+#endif
+
+// the write-ahead log of a MyGraph: every addition and deletion is appended as a binary record,
+// and a crashed process recovers by loading the last checkpoint and replaying the records after it
+//
+// the files of a log with base path B:
+//   B.manifest     the current generation g (a decimal number); replaced atomically by checkpoint
+//   B.<g>.snap     the checkpoint of generation g (MyGraph::save); generation 0 starts from an empty graph and has none
+//   B.<g>.wal      the mutations since that checkpoint: [MyGraphLogHeader][record][record]...
+//                  record: uint32 payload bytes, uint32 FNV-1a checksum of the payload, payload
+//                  payload: uint8 MyGraphLogRecordType and its fields (IDs as int64, data encoded by MySnapshotCodec)
+//
+// records are collected in memory and written in groups by a background thread, one fsync per group
+// (group commit), so mutations do not wait for the disk; a crash loses at most the group being collected
+// and the one being written, unless sync was called after the mutation
+// a record cut short by a crash (or damaged) ends the replay; everything before it is recovered
+// the log grows until checkpoint is called, or, with a checkpoint_bytes threshold, until a mutation leaves
+// at least that many bytes in the current log; the checkpoint then runs on the mutating thread
+
+// the kinds of log records
+enum MyGraphLogRecordType
+{
+    LOG_ADD_VERTEX = 1,         // vid, data
+    LOG_ADD_EDGE = 2,           // eid, sid, tid, data
+    LOG_DELETE_VERTEX = 3,      // vid (the deletion of its edges is implied and not logged)
+    LOG_DELETE_EDGE = 4,        // eid
+    LOG_DELETE_VERTICES = 5,    // count, vid... (as LOG_DELETE_VERTEX)
+    LOG_DELETE_EDGES = 6        // count, eid...
+};
+
+static const uint32_t MYGRAPHLOG_VERSION = 2;
+
+struct MyGraphLogHeader
+{
+    char magic[8];                  // "MYGRWAL" followed by '\0'
+    uint32_t version;               // MYGRAPHLOG_VERSION
+    uint32_t endian_check;          // MYSNAPSHOT_ENDIAN_CHECK as written by the logging machine
+    uint32_t vertex_data_kind;      // as in MySnapshotHeader
+    uint32_t vertex_data_bytes;
+    uint32_t edge_data_kind;
+    uint32_t edge_data_bytes;
+    uint32_t directed;              // as in MySnapshotHeader
+    uint32_t reserved;              // 0
+};
+
+// the write-ahead log of one graph; attaches itself to the graph it recovers (see open)
+// mutations must come from one thread at a time (as for MyGraph itself); the log adds one background writer thread
+// close the log (or destroy it) before the graph
+template <typename VertexDataType, typename EdgeDataType, typename GraphPolicy>
+class MyGraphLog : public MyGraphLogSink<VertexDataType, EdgeDataType>
+{
+  public:
+    typedef MyGraph<VertexDataType, EdgeDataType, GraphPolicy> GraphType;
+
+    // group_bytes: a group is written as soon as this many bytes of records are pending
+    // group_interval_ms: otherwise, pending records are written at the latest after this long
+    // checkpoint_bytes: a checkpoint is taken after the mutation that makes the current log this long (0: never)
+    explicit MyGraphLog(const size_t group_bytes = 1 << 16, const unsigned group_interval_ms = 10,
+                        const unsigned long long checkpoint_bytes = 0) :
+        graph(nullptr),
+        file(nullptr),
+        generation(0),
+        group_bytes(group_bytes),
+        group_interval(group_interval_ms),
+        checkpoint_bytes(checkpoint_bytes),
+        log_bytes(0),
+        appended(0),
+        durable(0),
+        num_syncs(0),
+        num_replayed(0),
+        sync_requested(false),
+        stopping(false),
+        failed(false)
+    {
+        return;
+    }
+
+    // destructor; writes the pending records and detaches from the graph
+    ~MyGraphLog()
+    {
+        close();
+    }
+
+    MyGraphLog(const MyGraphLog&) = delete;
+    MyGraphLog& operator=(const MyGraphLog&) = delete;
+
+    // recovers g from the log files at base_path and attaches the log to it
+    // g must be empty; loads the current checkpoint (if any) and replays the records after it
+    // starts a new log if there is none; a damaged tail is cut off by an immediate checkpoint
+    // returns false if the log files cannot be created or written
+    // throws std::domain_error if the checkpoint or the log belong to another graph type or do not match
+    // each other (g is left empty then)
+    bool open(const std::string& base_path, GraphType& g)
+    {
+        MYGRAPH_SPAN("MyGraphLog", "open");
+        close();
+        if(!g.empty() || g.numEdges() != 0)
+        {
+            throw std::domain_error("MyGraphLog::open: the graph must be empty");
+        }
+        base = base_path;
+        bool torn = false;
+        try
+        {
+            generation = readManifest();
+            if(generation > 0 && !g.load(snapshotPath(generation)))
+            {
+                throw std::domain_error("MyGraphLog::open: the checkpoint snapshot is missing");
+            }
+            MyMappedFile wal;
+            if(wal.open(logPath(generation)))
+            {
+                size_t intact = replay(wal, g);
+                torn = (intact < wal.size());
+                log_bytes = (intact < sizeof(MyGraphLogHeader)) ? sizeof(MyGraphLogHeader) : intact;
+                wal.close();
+                // a log cut short before its header was complete gets a fresh header: records appended
+                // after the partial header would make the next open reject the file
+                file = (intact < sizeof(MyGraphLogHeader)) ? createLog(logPath(generation))
+                                                           : std::fopen(logPath(generation).c_str(), "ab");
+            }
+            else
+            {
+                file = createLog(logPath(generation));
+                log_bytes = sizeof(MyGraphLogHeader);
+            }
+        }
+        catch(...)
+        {
+            g.releaseAll();
+            throw;
+        }
+        if(file == nullptr)
+        {
+            return false;
+        }
+        failed = false;
+        stopping = false;
+        flusher = std::thread(&MyGraphLog::flushLoop, this);
+        graph = &g;
+        g.setLog(this);
+        // new records must not follow the damaged bytes
+        if(torn && !checkpoint())
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    // waits until every record appended so far is on disk
+    // returns false if a write has failed since the log was opened
+    bool sync()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(file == nullptr)
+        {
+            return !failed;
+        }
+        unsigned long long target = appended;
+        sync_requested = true;
+        cv_flush.notify_one();
+        cv_durable.wait(lock, [&] { return durable >= target; });
+        return !failed;
+    }
+
+    // writes a checkpoint of the graph and starts an empty log on top of it, then removes the previous generation
+    // a crash at any point recovers either the old checkpoint with the old log or the new checkpoint
+    // returns false if a file cannot be written (the old generation then stays current)
+    bool checkpoint()
+    {
+        MYGRAPH_SPAN("MyGraphLog", "checkpoint");
+        if(graph == nullptr || !sync())
+        {
+            return false;
+        }
+        unsigned long long next = generation + 1;
+        std::string snapshot_tmp = snapshotPath(next) + ".tmp";
+        if(!graph->save(snapshot_tmp) || !syncFile(snapshot_tmp)
+           || std::rename(snapshot_tmp.c_str(), snapshotPath(next).c_str()) != 0)
+        {
+            std::remove(snapshot_tmp.c_str());
+            return false;
+        }
+        FILE* next_file = createLog(logPath(next));
+        if(next_file == nullptr || !writeManifest(next))
+        {
+            if(next_file != nullptr)
+            {
+                std::fclose(next_file);
+            }
+            std::remove(logPath(next).c_str());
+            std::remove(snapshotPath(next).c_str());
+            return false;
+        }
+        {
+            // the writer thread is idle: everything was synced and only this thread appends
+            std::lock_guard<std::mutex> lock(mtx);
+            std::fclose(file);
+            file = next_file;
+        }
+        std::remove(logPath(generation).c_str());
+        std::remove(snapshotPath(generation).c_str());
+        generation = next;
+        log_bytes = sizeof(MyGraphLogHeader);
+        return true;
+    }
+
+    // writes the pending records, stops the writer thread and detaches from the graph
+    // returns false if a write has failed since the log was opened
+    bool close()
+    {
+        if(graph == nullptr)
+        {
+            return !failed;
+        }
+        bool ok = sync();
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv_flush.notify_one();
+        flusher.join();
+        std::fclose(file);
+        file = nullptr;
+        graph->setLog(nullptr);
+        graph = nullptr;
+        return ok;
+    }
+
+    // returns the number of records appended since the log was constructed
+    unsigned long long numRecords() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return appended;
+    }
+
+    // returns the number of groups written (one fsync each)
+    unsigned long long numSyncs() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return num_syncs;
+    }
+
+    // returns the number of records replayed by open
+    unsigned long long numReplayed() const
+    {
+        return num_replayed;
+    }
+
+    // returns the current generation (the number of checkpoints behind the current log)
+    unsigned long long currentGeneration() const
+    {
+        return generation;
+    }
+
+    // the mutation hooks called by the graph
+    void logAddVertex(const VertexIDType vid, const VertexDataType& v_data) override
+    {
+        beginRecord(LOG_ADD_VERTEX);
+        putID(vid);
+        MySnapshotCodec<VertexDataType>::append(record, v_data);
+        appendRecord();
+    }
+
+    void logAddEdge(const EdgeIDType eid, const VertexIDType sid, const VertexIDType tid, const EdgeDataType& e_data) override
+    {
+        beginRecord(LOG_ADD_EDGE);
+        putID(eid);
+        putID(sid);
+        putID(tid);
+        MySnapshotCodec<EdgeDataType>::append(record, e_data);
+        appendRecord();
+    }
+
+    void logDeleteVertex(const VertexIDType vid) override
+    {
+        beginRecord(LOG_DELETE_VERTEX);
+        putID(vid);
+        appendRecord();
+    }
+
+    void logDeleteEdge(const EdgeIDType eid) override
+    {
+        beginRecord(LOG_DELETE_EDGE);
+        putID(eid);
+        appendRecord();
+    }
+
+    void logDeleteVertices(const MyVector<VertexIDType>& vids) override
+    {
+        beginRecord(LOG_DELETE_VERTICES);
+        putID(static_cast<int64_t>(vids.size()));
+        for(size_t i = 0; i < vids.size(); ++ i)
+        {
+            putID(vids[i]);
+        }
+        appendRecord();
+    }
+
+    void logDeleteEdges(const MyVector<EdgeIDType>& eids) override
+    {
+        beginRecord(LOG_DELETE_EDGES);
+        putID(static_cast<int64_t>(eids.size()));
+        for(size_t i = 0; i < eids.size(); ++ i)
+        {
+            putID(eids[i]);
+        }
+        appendRecord();
+    }
+
+    // checkpoints once the current log has reached checkpoint_bytes
+    // (a failed checkpoint keeps the old generation and is retried after another checkpoint_bytes)
+    void logCommit() override
+    {
+        if(checkpoint_bytes != 0 && log_bytes >= checkpoint_bytes && !checkpoint())
+        {
+            log_bytes = sizeof(MyGraphLogHeader);
+        }
+    }
+
+  private:
+    static const size_t MAX_PENDING_GROUPS = 16;   // mutations wait once this many groups are pending
+
+    GraphType* graph;                       // the attached graph (nullptr while closed)
+    std::string base;                       // the base path of the log files
+    FILE* file;                             // the current log file (replaced by checkpoint while the writer is idle)
+    unsigned long long generation;          // the current generation
+    const size_t group_bytes;
+    const std::chrono::milliseconds group_interval;
+    const unsigned long long checkpoint_bytes;
+    unsigned long long log_bytes;           // the size of the current log with the records appended to it (mutating thread only)
+    std::string record;                     // the payload being encoded (used by the mutating thread only)
+    std::string writing;                    // the group being written (used by the writer thread only)
+    std::thread flusher;                    // the writer thread
+    mutable std::mutex mtx;                 // guards the fields below
+    std::condition_variable cv_flush;       // wakes the writer thread
+    std::condition_variable cv_durable;     // signals that a group was taken or written
+    std::string pending;                    // the records not yet taken by the writer thread
+    unsigned long long appended;            // the number of records appended
+    unsigned long long durable;             // the number of records written and synced
+    unsigned long long num_syncs;           // the number of groups written
+    unsigned long long num_replayed;        // the number of records replayed by open
+    bool sync_requested;                    // whether a thread waits in sync
+    bool stopping;                          // set by close to stop the writer thread
+    bool failed;                            // whether a write or an fsync has failed
+
+    // the loop of the writer thread: takes the pending records as one group, writes and syncs them
+    void flushLoop()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        while(true)
+        {
+            cv_flush.wait_for(lock, group_interval, [&] { return stopping || sync_requested || pending.size() >= group_bytes; });
+            if(pending.empty())
+            {
+                sync_requested = false;
+                if(stopping)
+                {
+                    return;
+                }
+                continue;
+            }
+            writing.swap(pending);
+            unsigned long long group_end = appended;
+            FILE* out = file;
+            sync_requested = false;
+            cv_durable.notify_all();
+            lock.unlock();
+            bool ok = (std::fwrite(writing.data(), 1, writing.size(), out) == writing.size()) && syncStream(out);
+            writing.clear();
+            lock.lock();
+            failed = failed || !ok;
+            durable = group_end;
+            ++ num_syncs;
+            cv_durable.notify_all();
+        }
+    }
+
+    // starts encoding a record of type t
+    void beginRecord(const MyGraphLogRecordType t)
+    {
+        record.clear();
+        record.push_back(static_cast<char>(t));
+        return;
+    }
+
+    // appends an ID (or a count) to the record being encoded
+    void putID(const int64_t id)
+    {
+        record.append(reinterpret_cast<const char*>(&id), sizeof(id));
+        return;
+    }
+
+    // frames the encoded record and hands it to the writer thread
+    // waits while MAX_PENDING_GROUPS groups are already pending (the disk is behind)
+    void appendRecord()
+    {
+        uint32_t len = static_cast<uint32_t>(record.size());
+        uint32_t sum = checksum(record.data(), record.size());
+        log_bytes += sizeof(len) + sizeof(sum) + record.size();
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_durable.wait(lock, [&] { return pending.size() < MAX_PENDING_GROUPS * group_bytes; });
+        pending.append(reinterpret_cast<const char*>(&len), sizeof(len));
+        pending.append(reinterpret_cast<const char*>(&sum), sizeof(sum));
+        pending.append(record);
+        ++ appended;
+        if(pending.size() >= group_bytes)
+        {
+            cv_flush.notify_one();
+        }
+        return;
+    }
+
+    // FNV-1a over [data, data + n)
+    static uint32_t checksum(const char* data, const size_t n)
+    {
+        uint32_t h = 2166136261u;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            h = (h ^ static_cast<unsigned char>(data[i])) * 16777619u;
+        }
+        return h;
+    }
+
+    // replays the records of wal into g
+    // returns the number of bytes holding the header and complete, intact records
+    size_t replay(const MyMappedFile& wal, GraphType& g)
+    {
+        MYGRAPH_SPAN("MyGraphLog", "replay");
+        // a crash while the log was being created leaves less than a header (open then recreates the file)
+        if(wal.size() < sizeof(MyGraphLogHeader))
+        {
+            return 0;
+        }
+        MyGraphLogHeader header;
+        std::memcpy(&header, wal.data(), sizeof(header));
+        if(std::memcmp(header.magic, "MYGRWAL", 8) != 0 || header.version != MYGRAPHLOG_VERSION
+           || header.endian_check != MYSNAPSHOT_ENDIAN_CHECK)
+        {
+            throw std::domain_error("MyGraphLog::open: not a graph log");
+        }
+        if(header.vertex_data_kind != MySnapshotCodec<VertexDataType>::KIND || header.vertex_data_bytes != MySnapshotCodec<VertexDataType>::BYTES
+           || header.edge_data_kind != MySnapshotCodec<EdgeDataType>::KIND || header.edge_data_bytes != MySnapshotCodec<EdgeDataType>::BYTES)
+        {
+            throw std::domain_error("MyGraphLog::open: log written for other vertex or edge data types");
+        }
+        if((header.directed != 0) != GraphPolicy::directed)
+        {
+            throw std::domain_error(GraphPolicy::directed ? "MyGraphLog::open: log written for an undirected graph"
+                                                          : "MyGraphLog::open: log written for a directed graph");
+        }
+        const char* p = wal.data() + sizeof(header);
+        const char* end = wal.data() + wal.size();
+        while(end - p >= 8)
+        {
+            uint32_t len, sum;
+            std::memcpy(&len, p, sizeof(len));
+            std::memcpy(&sum, p + 4, sizeof(sum));
+            if(len == 0 || static_cast<size_t>(end - p - 8) < len || checksum(p + 8, len) != sum)
+            {
+                break;
+            }
+            applyRecord(g, p + 8, p + 8 + len);
+            p += 8 + len;
+            ++ num_replayed;
+        }
+        return static_cast<size_t>(p - wal.data());
+    }
+
+    // reads an ID (or a count) from [p, end) and advances p
+    static int64_t getID(const char*& p, const char* end)
+    {
+        int64_t id;
+        if(static_cast<size_t>(end - p) < sizeof(id))
+        {
+            throw std::domain_error("MyGraphLog::open: corrupted log record");
+        }
+        std::memcpy(&id, p, sizeof(id));
+        p += sizeof(id);
+        return id;
+    }
+
+    // applies the record [p, end) to g
+    void applyRecord(GraphType& g, const char* p, const char* end)
+    {
+        char t = *p ++;
+        try
+        {
+            if(t == LOG_ADD_VERTEX)
+            {
+                VertexIDType vid = getID(p, end);
+                VertexDataType v_data;
+                if(!MySnapshotCodec<VertexDataType>::decode(p, end, v_data))
+                {
+                    throw std::domain_error("MyGraphLog::open: corrupted log record");
+                }
+                g.restoreVertex(vid, std::move(v_data));
+            }
+            else if(t == LOG_ADD_EDGE)
+            {
+                EdgeIDType eid = getID(p, end);
+                VertexIDType sid = getID(p, end);
+                VertexIDType tid = getID(p, end);
+                EdgeDataType e_data;
+                if(!MySnapshotCodec<EdgeDataType>::decode(p, end, e_data))
+                {
+                    throw std::domain_error("MyGraphLog::open: corrupted log record");
+                }
+                g.restoreEdge(eid, sid, tid, std::move(e_data));
+            }
+            else if(t == LOG_DELETE_VERTEX)
+            {
+                g.deleteVertex(getID(p, end));
+            }
+            else if(t == LOG_DELETE_EDGE)
+            {
+                g.deleteEdge(getID(p, end));
+            }
+            else if(t == LOG_DELETE_VERTICES || t == LOG_DELETE_EDGES)
+            {
+                int64_t count = getID(p, end);
+                if(count < 0 || static_cast<uint64_t>(end - p) / sizeof(int64_t) < static_cast<uint64_t>(count))
+                {
+                    throw std::domain_error("MyGraphLog::open: corrupted log record");
+                }
+                MyVector<long long> ids(static_cast<size_t>(count));
+                for(size_t i = 0; i < ids.size(); ++ i)
+                {
+                    ids[i] = getID(p, end);
+                }
+                if(t == LOG_DELETE_VERTICES)
+                {
+                    g.deleteVertices(ids);
+                }
+                else
+                {
+                    g.deleteEdges(ids);
+                }
+            }
+            else
+            {
+                throw std::domain_error("MyGraphLog::open: unknown log record");
+            }
+        }
+        catch(const std::out_of_range&)
+        {
+            throw std::domain_error("MyGraphLog::open: the log does not match the checkpoint");
+        }
+        if(p != end)
+        {
+            throw std::domain_error("MyGraphLog::open: corrupted log record");
+        }
+        return;
+    }
+
+    // returns the path of the checkpoint of generation g
+    std::string snapshotPath(const unsigned long long g) const
+    {
+        return base + "." + std::to_string(g) + ".snap";
+    }
+
+    // returns the path of the log of generation g
+    std::string logPath(const unsigned long long g) const
+    {
+        return base + "." + std::to_string(g) + ".wal";
+    }
+
+    // returns the generation named by the manifest (0 if there is none)
+    unsigned long long readManifest() const
+    {
+        FILE* f = std::fopen((base + ".manifest").c_str(), "rb");
+        if(f == nullptr)
+        {
+            return 0;
+        }
+        unsigned long long g = 0;
+        int got = std::fscanf(f, "%llu", &g);
+        std::fclose(f);
+        if(got != 1)
+        {
+            throw std::domain_error("MyGraphLog::open: corrupted manifest");
+        }
+        return g;
+    }
+
+    // makes generation g current: writes the manifest next to the old one and renames it over it
+    bool writeManifest(const unsigned long long g) const
+    {
+        std::string path = base + ".manifest";
+        std::string tmp = path + ".tmp";
+        FILE* f = std::fopen(tmp.c_str(), "wb");
+        if(f == nullptr)
+        {
+            return false;
+        }
+        bool ok = (std::fprintf(f, "%llu\n", g) > 0) && syncStream(f);
+        ok = (std::fclose(f) == 0) && ok;
+        if(!ok || std::rename(tmp.c_str(), path.c_str()) != 0)
+        {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        return syncDirectory();
+    }
+
+    // creates an empty log file at path (the header only) and returns it opened for appending
+    // returns nullptr if it cannot be written
+    FILE* createLog(const std::string& path) const
+    {
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if(f == nullptr)
+        {
+            return nullptr;
+        }
+        MyGraphLogHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "MYGRWAL", 8);
+        header.version = MYGRAPHLOG_VERSION;
+        header.endian_check = MYSNAPSHOT_ENDIAN_CHECK;
+        header.vertex_data_kind = MySnapshotCodec<VertexDataType>::KIND;
+        header.vertex_data_bytes = MySnapshotCodec<VertexDataType>::BYTES;
+        header.edge_data_kind = MySnapshotCodec<EdgeDataType>::KIND;
+        header.edge_data_bytes = MySnapshotCodec<EdgeDataType>::BYTES;
+        header.directed = (GraphPolicy::directed ? 1 : 0);
+        if(std::fwrite(&header, sizeof(header), 1, f) != 1 || !syncStream(f))
+        {
+            std::fclose(f);
+            return nullptr;
+        }
+        return f;
+    }
+
+    // flushes f and forces its contents to disk
+    static bool syncStream(FILE* f)
+    {
+        if(std::fflush(f) != 0)
+        {
+            return false;
+        }
+#if MYGRAPH_HAVE_FSYNC
+        return ::fsync(fileno(f)) == 0;
+#else
+        return true;
+#endif
+    }
+
+    // forces the contents of the file at path to disk
+    static bool syncFile(const std::string& path)
+    {
+#if MYGRAPH_HAVE_FSYNC
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            return false;
+        }
+        bool ok = (::fsync(fd) == 0);
+        ::close(fd);
+        return ok;
+#else
+        (void)path;
+        return true;
+#endif
+    }
+
+    // forces the directory entries of the log files (renames, creations) to disk
+    bool syncDirectory() const
+    {
+        size_t slash = base.find_last_of('/');
+        return syncFile(slash == std::string::npos ? std::string(".") : (slash == 0 ? std::string("/") : base.substr(0, slash)));
+    }
+};
+
+#endif // __MYGRAPHLOG_H__
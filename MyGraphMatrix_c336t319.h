@@ -0,0 +1,434 @@
+#ifndef __MYGRAPHMATRIX_H__
+#define __MYGRAPHMATRIX_H__
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "MyGraph_Template.h"
+#include "MyIDMap_c336t319.h"
+#include "MyThreadPool_c336t319.h"
+#include "MyVector_c336t319.h"
+
+// the adjacency matrix of a MyGraph in CSR (compressed sparse row) form, for iterative sparse matrix-vector products
+// row r is the vertex at vertex_set position r when build was called; its entries are the rows of the vertices with an
+// edge into it (both ends of every edge in undirected graphs), so a product pulls: every row reads its in-neighbours
+// and writes only itself, and the rows are split among the threads without atomics or locks
+// an entry's value is 1, or the edge property (converted to double) if the matrix is built with weights;
+// parallel edges give one entry each
+// the matrix is a copy: it does not follow later changes of the graph (build again, O(n + m))
+// sums are taken in fixed chunks of rows and added in chunk order, so every result is the same for any number of threads
+template <typename VertexDataType, typename EdgeDataType, typename GraphPolicy>
+class MyGraphMatrix
+{
+  public:
+    typedef MyGraph<VertexDataType, EdgeDataType, GraphPolicy> GraphType;     // the graph type the matrix is taken from
+
+    // what an iteration did, one element per iteration
+    struct IterationReport
+    {
+        size_t iterations;              // the number of iterations run
+        bool converged;                 // whether the last change was within the tolerance
+        MyVector<double> residuals;     // the change of the vector in each iteration (L1 norm)
+        MyVector<double> iteration_ms;  // the wall-clock time of each iteration in milliseconds
+    };
+
+    // default constructor; holds no rows
+    MyGraphMatrix() :
+        has_weights(false),
+        has_negative(false)
+    {
+        return;
+    }
+
+    // builds the matrix of graph (see build)
+    explicit MyGraphMatrix(const GraphType& graph, const bool use_weights = false) :
+        has_weights(false),
+        has_negative(false)
+    {
+        build(graph, use_weights);
+    }
+
+    // replaces the matrix with the one of graph; with use_weights, the entries take the edge properties as values
+    // throws std::domain_error if the graph has more than 2^32 - 1 vertices, or if use_weights is set and
+    // EdgeDataType is not an arithmetic type
+    // expected time complexity: O(n + m)
+    void build(const GraphType& graph, const bool use_weights = false)
+    {
+        MYGRAPH_SPAN("MyGraphMatrix", "build");
+        size_t n = graph.vertex_set.size();
+        size_t m = graph.edge_set.size();
+        if(n > UINT32_MAX)
+        {
+            throw std::domain_error("MyGraphMatrix build: too many vertices");
+        }
+        if(use_weights && !std::is_arithmetic<EdgeDataType>::value)
+        {
+            throw std::domain_error("MyGraphMatrix build: the edge property is not a number");
+        }
+        MyVector<VertexIDType> new_vertex_ids(n);
+        for(size_t i = 0; i < n; ++ i)
+        {
+            new_vertex_ids[i] = graph.vertex_set[i]->id;
+        }
+        MyVector<uint32_t> edge_src(m);
+        MyVector<uint32_t> edge_tgt(m);
+        MyVector<size_t> new_offsets(n + 1);
+        for(size_t r = 0; r <= n; ++ r)
+        {
+            new_offsets[r] = 0;
+        }
+        for(size_t j = 0; j < m; ++ j)
+        {
+            size_t pos_s = 0, pos_t = 0;
+            if(!graph.vertex_map.get(graph.edge_set[j]->src, pos_s) || !graph.vertex_map.get(graph.edge_set[j]->tgt, pos_t))
+            {
+                throw std::out_of_range("MyGraphMatrix build: edge end vertex not found");
+            }
+            edge_src[j] = static_cast<uint32_t>(pos_s);
+            edge_tgt[j] = static_cast<uint32_t>(pos_t);
+            ++ new_offsets[pos_t + 1];
+            if(!GraphPolicy::directed && pos_s != pos_t)
+            {
+                ++ new_offsets[pos_s + 1];
+            }
+        }
+        for(size_t r = 0; r < n; ++ r)
+        {
+            new_offsets[r + 1] += new_offsets[r];
+        }
+
+        // the entries of each row in edge_set order; the column sums (the out-weights) along the way
+        MyVector<uint32_t> new_cols(new_offsets[n]);
+        MyVector<double> new_vals(use_weights ? new_offsets[n] : 0);
+        MyVector<double> out_weight(n);
+        MyVector<size_t> cursor(n);
+        for(size_t r = 0; r < n; ++ r)
+        {
+            out_weight[r] = 0;
+            cursor[r] = new_offsets[r];
+        }
+        bool negative = false;
+        for(size_t j = 0; j < m; ++ j)
+        {
+            double w = 1;
+            if(use_weights)
+            {
+                w = toWeight(graph.edge_set[j]->data, std::is_arithmetic<EdgeDataType>());
+                negative = negative || w < 0;
+            }
+            uint32_t s = edge_src[j];
+            uint32_t t = edge_tgt[j];
+            if(use_weights)
+            {
+                new_vals[cursor[t]] = w;
+            }
+            new_cols[cursor[t] ++] = s;
+            out_weight[s] += w;
+            if(!GraphPolicy::directed && s != t)
+            {
+                if(use_weights)
+                {
+                    new_vals[cursor[s]] = w;
+                }
+                new_cols[cursor[s] ++] = t;
+                out_weight[t] += w;
+            }
+        }
+        // 0 marks a dangling row (nothing to pass its rank on to)
+        MyVector<double> new_inv_out(n);
+        for(size_t r = 0; r < n; ++ r)
+        {
+            new_inv_out[r] = (out_weight[r] > 0 ? 1.0 / out_weight[r] : 0.0);
+        }
+        vertex_ids = std::move(new_vertex_ids);
+        offsets = std::move(new_offsets);
+        cols = std::move(new_cols);
+        vals = std::move(new_vals);
+        inv_out_weight = std::move(new_inv_out);
+        vertex_map = graph.vertex_map;
+        has_weights = use_weights;
+        has_negative = negative;
+        return;
+    }
+
+    // releases the matrix
+    void clear()
+    {
+        vertex_ids = MyVector<VertexIDType>();
+        offsets = MyVector<size_t>();
+        cols = MyVector<uint32_t>();
+        vals = MyVector<double>();
+        inv_out_weight = MyVector<double>();
+        vertex_map.clear();
+        has_weights = false;
+        has_negative = false;
+        return;
+    }
+
+    // returns the number of rows (vertices)
+    size_t numVertices(void) const
+    {
+        return vertex_ids.size();
+    }
+
+    // returns the number of entries
+    size_t numEntries(void) const
+    {
+        return cols.size();
+    }
+
+    // returns whether the entries take the edge properties as values
+    bool weighted(void) const
+    {
+        return has_weights;
+    }
+
+    // returns the ID of the vertex of row r (no bounds check)
+    VertexIDType vertexID(const size_t r) const
+    {
+        return vertex_ids[r];
+    }
+
+    // returns the row of the vertex vid
+    // throws std::out_of_range if vid has no row
+    size_t vertexRow(const VertexIDType vid) const
+    {
+        size_t pos;
+        if(!vertex_map.get(vid, pos))
+        {
+            throw std::out_of_range("MyGraphMatrix vertexRow: vertex ID not found");
+        }
+        return pos;
+    }
+
+    // computes y = A x on the threads of pool: y[r] is the sum of value * x[c] over the entries (c, value) of row r
+    // throws std::domain_error if x does not have one element per row
+    void multiply(const MyVector<double>& x, MyVector<double>& y, MyThreadPool& pool) const
+    {
+        MYGRAPH_SPAN("MyGraphMatrix", "multiply");
+        size_t n = numVertices();
+        if(x.size() != n)
+        {
+            throw std::domain_error("MyGraphMatrix multiply: x does not have one element per row");
+        }
+        MyVector<double> result(n);
+        if(n > 0)
+        {
+            pullRows(&x[0], &x[0], &result[0], [](size_t, double sum) { return sum; }, pool);
+        }
+        y = std::move(result);
+        return;
+    }
+
+    // iterates x <- update(r, (A x)[r]) for every row r, with two buffers, until the change of x (L1 norm) is at most
+    // tolerance or max_iterations iterations have run; returns the number of iterations
+    // update must be safe to call from several threads at once; report (if not nullptr) gets the per-iteration details
+    // throws std::domain_error if x does not have one element per row
+    template <typename UpdateType>
+    size_t iterate(MyVector<double>& x, UpdateType update, const size_t max_iterations, const double tolerance,
+                   MyThreadPool& pool, IterationReport* report = nullptr) const
+    {
+        MYGRAPH_SPAN("MyGraphMatrix", "iterate");
+        size_t n = numVertices();
+        if(x.size() != n)
+        {
+            throw std::domain_error("MyGraphMatrix iterate: x does not have one element per row");
+        }
+        MyVector<double> next(n);
+        beginReport(report);
+        size_t done = 0;
+        while(done < max_iterations && n > 0)
+        {
+            auto start = std::chrono::steady_clock::now();
+            double residual = pullRows(&x[0], &x[0], &next[0], update, pool);
+            std::swap(x, next);
+            ++ done;
+            if(recordIteration(report, residual, start, tolerance))
+            {
+                break;
+            }
+        }
+        return done;
+    }
+
+    // computes the PageRank of every vertex on the threads of pool; ranks[r] is the rank of row r, and the ranks add up to 1
+    // a vertex passes damping times its rank on along its outgoing edges (in proportion to their values if weighted),
+    // the rank of dangling vertices is spread over all vertices, and every vertex gets (1 - damping) / n on top
+    // stops once the ranks change by at most tolerance (L1 norm) or after max_iterations iterations; returns the iterations
+    // throws std::domain_error if damping is not in [0, 1] or some weight is negative
+    size_t pageRank(MyVector<double>& ranks, MyThreadPool& pool, const double damping = 0.85, const double tolerance = 1e-9,
+                    const size_t max_iterations = 100, IterationReport* report = nullptr) const
+    {
+        MYGRAPH_SPAN("MyGraphMatrix", "pageRank");
+        if(!(damping >= 0 && damping <= 1))
+        {
+            throw std::domain_error("MyGraphMatrix pageRank: damping is not in [0, 1]");
+        }
+        if(has_negative)
+        {
+            throw std::domain_error("MyGraphMatrix pageRank: negative edge weight");
+        }
+        size_t n = numVertices();
+        MyVector<double> rank(n);
+        MyVector<double> next(n);
+        MyVector<double> contrib(n);
+        for(size_t r = 0; r < n; ++ r)
+        {
+            rank[r] = 1.0 / n;
+        }
+        beginReport(report);
+        size_t done = 0;
+        while(done < max_iterations && n > 0)
+        {
+            auto start = std::chrono::steady_clock::now();
+            // the share every out-edge passes on, and the rank held by dangling vertices
+            double dangling = sumChunks(n, pool, [&](size_t lo, size_t hi)
+            {
+                double held = 0;
+                for(size_t r = lo; r < hi; ++ r)
+                {
+                    contrib[r] = rank[r] * inv_out_weight[r];
+                    held += (inv_out_weight[r] == 0 ? rank[r] : 0.0);
+                }
+                return held;
+            });
+            double base = (1 - damping) / n + damping * dangling / n;
+            double residual = pullRows(&contrib[0], &rank[0], &next[0], [&](size_t, double sum) { return base + damping * sum; }, pool);
+            std::swap(rank, next);
+            ++ done;
+            if(recordIteration(report, residual, start, tolerance))
+            {
+                break;
+            }
+        }
+        ranks = std::move(rank);
+        return done;
+    }
+
+    // returns the bytes held by the matrix
+    size_t memoryUsage(void) const
+    {
+        return sizeof(*this) + vertex_ids.memoryUsage() + offsets.memoryUsage() + cols.memoryUsage() + vals.memoryUsage()
+               + inv_out_weight.memoryUsage() + vertex_map.memoryUsage();
+    }
+
+  private:
+
+    static const size_t PULL_CHUNK = 1024;  // the rows per task, and per partial sum
+    static const size_t PULL_LANES = 4;     // the independent accumulators of a row sum
+
+    MyVector<VertexIDType> vertex_ids;      // the vertex ID of each row
+    MyVector<size_t> offsets;               // the entries of row r are cols[offsets[r]], ..., cols[offsets[r + 1] - 1]
+    MyVector<uint32_t> cols;                // the column (the row of the in-neighbour) of each entry
+    MyVector<double> vals;                  // the value of each entry (empty without weights: every value is 1)
+    MyVector<double> inv_out_weight;        // 1 / (the sum of the values in each column), 0 for an empty column
+    MyIDMap vertex_map;                     // the mapping between a vertex ID and its row
+    bool has_weights;                       // whether vals holds the values
+    bool has_negative;                      // whether some value is negative
+
+    template <typename DataType>
+    static double toWeight(const DataType& data, std::true_type)
+    {
+        return static_cast<double>(data);
+    }
+
+    template <typename DataType>
+    static double toWeight(const DataType&, std::false_type)
+    {
+        return 1;
+    }
+
+    // adds up func(lo, hi) over the chunks [lo, hi) of the rows, in chunk order
+    template <typename FuncType>
+    static double sumChunks(const size_t n, MyThreadPool& pool, FuncType func)
+    {
+        MyVector<double> partial((n + PULL_CHUNK - 1) / PULL_CHUNK);
+        pool.parallelFor(0, n, PULL_CHUNK, [&](size_t, size_t lo, size_t hi)
+        {
+            // a pool without workers hands out the whole range at once; it is split the same way
+            for(size_t c = lo; c < hi; c += PULL_CHUNK)
+            {
+                partial[c / PULL_CHUNK] = func(c, std::min(hi, c + PULL_CHUNK));
+            }
+        });
+        double sum = 0;
+        for(size_t c = 0; c < partial.size(); ++ c)
+        {
+            sum += partial[c];
+        }
+        return sum;
+    }
+
+    // sets out[r] = update(r, sum of value * in[c] over the entries (c, value) of row r) for every row
+    // returns the sum of |out[r] - prev[r]|
+    template <typename UpdateType>
+    double pullRows(const double* in, const double* prev, double* out, UpdateType update, MyThreadPool& pool) const
+    {
+        return sumChunks(numVertices(), pool, [&](size_t lo, size_t hi)
+        {
+            double change = 0;
+            for(size_t r = lo; r < hi; ++ r)
+            {
+                double sum = (has_weights ? rowSum<true>(in, r) : rowSum<false>(in, r));
+                out[r] = update(r, sum);
+                change += (out[r] > prev[r] ? out[r] - prev[r] : prev[r] - out[r]);
+            }
+            return change;
+        });
+    }
+
+    // returns the sum of (value *) in[c] over the entries of row r, in PULL_LANES independent partial sums,
+    // so the loads of in[c] overlap instead of waiting on one chain of additions
+    template <bool Weighted>
+    double rowSum(const double* in, const size_t r) const
+    {
+        size_t k = offsets[r];
+        size_t end = offsets[r + 1];
+        double lanes[PULL_LANES] = {0, 0, 0, 0};
+        for(; k + PULL_LANES <= end; k += PULL_LANES)
+        {
+            for(size_t l = 0; l < PULL_LANES; ++ l)
+            {
+                lanes[l] += (Weighted ? vals[k + l] : 1.0) * in[cols[k + l]];
+            }
+        }
+        for(; k < end; ++ k)
+        {
+            lanes[0] += (Weighted ? vals[k] : 1.0) * in[cols[k]];
+        }
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    static void beginReport(IterationReport* report)
+    {
+        if(report != nullptr)
+        {
+            report->iterations = 0;
+            report->converged = false;
+            report->residuals.resize(0);
+            report->iteration_ms.resize(0);
+        }
+        return;
+    }
+
+    // records an iteration that began at start; returns whether residual is within tolerance
+    static bool recordIteration(IterationReport* report, const double residual, const std::chrono::steady_clock::time_point start,
+                                const double tolerance)
+    {
+        bool converged = residual <= tolerance;
+        if(report != nullptr)
+        {
+            ++ report->iterations;
+            report->converged = converged;
+            report->residuals.push_back(residual);
+            report->iteration_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return converged;
+    }
+};
+
+#endif // __MYGRAPHMATRIX_H__
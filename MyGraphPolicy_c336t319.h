@@ -0,0 +1,103 @@
+#ifndef __MYGRAPHPOLICY_H__
+#define __MYGRAPHPOLICY_H__
+
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+// the compile-time options of MyGraph (its third template argument); the default is the undirected graph
+//
+// Directed: every edge points from src to tgt; breadthFirstSearch, parallelBreadthFirstSearch, depthFirstSearch
+//     and hopDistance follow edges from src to tgt, and probeEdge(sid, tid) finds only the edges from sid to tid;
+//     isConnected, componentId and numComponents answer for weak connectivity (directions ignored), and degree
+//     counts the incoming and the outgoing edges; every edge is still listed at both ends, so deletions stay O(1)
+//     and bottom-up BFS steps can look for parents among the incoming edges
+// InlineNeighbors: every adjacency entry keeps the ID of the other end (and the direction) next to the edge ID,
+//     so a neighbour step reads neither the Edge object nor its end IDs; the entry grows from 8 to 24 bytes
+//
+// with the default options the per-step direction checks are compile-time constants and drop out of the code
+template <bool Directed = false, bool InlineNeighbors = false>
+struct MyGraphPolicy
+{
+    static const bool directed = Directed;
+    static const bool inline_neighbors = InlineNeighbors;
+};
+
+typedef MyGraphPolicy<false, false> MyUndirectedPolicy;
+typedef MyGraphPolicy<true, false> MyDirectedPolicy;
+
+// the property type of graphs whose vertices or edges carry no data, e.g. MyGraph<int, MyNoData>
+// an empty class: an Edge holds it in the padding after its tag, EdgeRecord through the empty-base optimization,
+// and snapshots and log records store 0 bytes for it
+struct MyNoData
+{
+};
+
+inline bool operator==(const MyNoData&, const MyNoData&)
+{
+    return true;
+}
+
+inline bool operator<(const MyNoData&, const MyNoData&)
+{
+    return false;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const MyNoData&)
+{
+    return os;
+}
+
+// holds a property as a base class instead of a member
+// an empty property type takes no bytes through the empty-base optimization; its data member is then one
+// shared static object, so code that reads or assigns x.data compiles unchanged for every property type
+template <typename DataType, bool IsEmpty = std::is_empty<DataType>::value>
+class MyPropertyHolder
+{
+  public:
+    MyPropertyHolder()
+    {
+        return;
+    }
+
+    explicit MyPropertyHolder(const DataType& d) :
+        data(d)
+    {
+        return;
+    }
+
+    explicit MyPropertyHolder(DataType && d) :
+        data(std::move(d))
+    {
+        return;
+    }
+
+    DataType data;      // the property
+};
+
+template <typename DataType>
+class MyPropertyHolder<DataType, true>
+{
+  public:
+    MyPropertyHolder()
+    {
+        return;
+    }
+
+    explicit MyPropertyHolder(const DataType&)
+    {
+        return;
+    }
+
+    explicit MyPropertyHolder(DataType &&)
+    {
+        return;
+    }
+
+    static DataType data;   // the property (empty, so every holder shares it)
+};
+
+template <typename DataType>
+DataType MyPropertyHolder<DataType, true>::data;
+
+#endif // __MYGRAPHPOLICY_H__
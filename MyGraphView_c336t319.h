@@ -0,0 +1,726 @@
+#ifndef __MYGRAPHVIEW_H__
+#define __MYGRAPHVIEW_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "MyCompressedAdjacency_c336t319.h"
+#include "MyGraph_Template.h"
+#include "MyMappedFile_c336t319.h"
+#include "MySnapshot_c336t319.h"
+
+// where MyGraphView reads the adjacency from
+enum MyViewStorage
+{
+    VIEW_MAPPED,        // the mapped CSR sections, paged in on demand
+    VIEW_COMPRESSED     // an in-memory delta + StreamVByte copy of the neighbour lists (see MyCompressedAdjacency_c336t319.h)
+};
+
+// read-only view of a graph snapshot (written by MyGraph::save) that stays on disk
+// the snapshot is memory-mapped and traversed through its CSR sections, so the adjacency
+// is paged in on demand instead of being held in memory; resident memory is O(n) bits to words
+// (visit marks, frontiers, the connectivity index, and an ID map if the vertex IDs are not 1..n)
+// offers the traversal API of MyGraph (same names, arguments and path orders), so query code can be
+// written against either of them
+// with VIEW_COMPRESSED, open decodes the neighbour section once into a MyCompressedAdjacency
+// (about 1-2 bytes per entry instead of the 8 of the neighbour and 8 of the edge section),
+// and the neighbour-only queries (degree, direction-optimizing BFS, connectivity, hopDistance) run on it;
+// the queries that need edge IDs or MyGraph's edge order (probeEdge, BFS in edge ID order, DFS) still read the file
+// the snapshot of a directed graph is traversed as MyGraph with MyDirectedPolicy traverses it (see MyGraphPolicy_c336t319.h):
+// BFS, DFS, hopDistance and probeEdge follow edges from src to tgt, connectivity is weak and degree counts both directions;
+// the direction of an entry is read from its flag in the edge section, or from separate out- and in-lists in compressed mode
+template <typename VertexDataType, typename EdgeDataType>
+class MyGraphView
+{
+  public:
+
+    // default constructor; views nothing
+    MyGraphView() :
+        reader(nullptr),
+        num_vertices(0),
+        num_edges(0),
+        v_ids(nullptr),
+        e_ids(nullptr),
+        adj_offsets(nullptr),
+        adj_edges(nullptr),
+        adj_nbrs(nullptr),
+        dense_ids(true),
+        directed(false),
+        compressed_mode(false),
+        vertex_map(),
+        conn_index(0),
+        conn_index_built(false),
+        search_stamp(0),
+        search_dist(0),
+        search_epoch(0)
+    {
+        return;
+    }
+
+    // destructor; unmaps the snapshot
+    ~MyGraphView()
+    {
+        close();
+    }
+
+    MyGraphView(const MyGraphView&) = delete;
+    MyGraphView& operator=(const MyGraphView&) = delete;
+
+    // maps the snapshot at path
+    // checks the header, the data types and the adjacency (one sequential pass over the offsets and the entries)
+    // with VIEW_COMPRESSED, also encodes the neighbour lists (a second sequential pass) and drops the adjacency pages
+    // returns false if the file cannot be opened
+    // throws std::domain_error if the file is not a valid snapshot of this graph type (the view is then closed)
+    bool open(const std::string& path, const MyViewStorage storage = VIEW_MAPPED)
+    {
+        MYGRAPH_SPAN("MyGraphView", "open");
+        close();
+        if(!file.open(path))
+        {
+            return false;
+        }
+        try
+        {
+            reader = new MySnapshotReader(file.data(), file.size());
+            reader->checkDataTypes<VertexDataType, EdgeDataType>();
+            reader->checkAdjacency();
+        }
+        catch(...)
+        {
+            close();
+            throw;
+        }
+        num_vertices = reader->info().num_vertices;
+        num_edges = reader->info().num_edges;
+        v_ids = reader->array<int64_t>(SNAP_VERTEX_IDS);
+        e_ids = reader->array<int64_t>(SNAP_EDGE_IDS);
+        adj_offsets = reader->array<uint64_t>(SNAP_ADJ_OFFSETS);
+        adj_edges = reader->array<uint64_t>(SNAP_ADJ_EDGES);
+        adj_nbrs = reader->array<uint64_t>(SNAP_ADJ_NEIGHBORS);
+        directed = (reader->info().directed != 0);
+
+        // snapshots of graphs without vertex deletions have the IDs 1..n in order and need no map
+        dense_ids = true;
+        for(size_t i = 0; i < num_vertices && dense_ids; ++ i)
+        {
+            dense_ids = (v_ids[i] == static_cast<int64_t>(i + 1));
+        }
+        if(!dense_ids)
+        {
+            // the n distinct IDs lie in 1..current_vertex_id; the map is sized by the largest ID actually stored,
+            // so a corrupted header value cannot make it allocate beyond what the file's IDs need
+            uint64_t last_id = reader->info().current_vertex_id;
+            bool valid = (last_id >= num_vertices && last_id <= static_cast<uint64_t>(INT64_MAX));
+            int64_t max_id = 0;
+            for(size_t i = 0; i < num_vertices && valid; ++ i)
+            {
+                valid = (v_ids[i] > 0 && static_cast<uint64_t>(v_ids[i]) <= last_id);
+                max_id = std::max(max_id, v_ids[i]);
+            }
+            vertex_map.clear();
+            if(valid)
+            {
+                vertex_map.reserve(max_id);
+            }
+            for(size_t i = 0; i < num_vertices && valid; ++ i)
+            {
+                valid = vertex_map.insert(v_ids[i], i);
+            }
+            if(!valid)
+            {
+                close();
+                throw std::domain_error("MyGraphView::open: corrupted snapshot (vertex IDs)");
+            }
+        }
+        if(storage == VIEW_COMPRESSED)
+        {
+            try
+            {
+                if(!directed)
+                {
+                    compressed.build(num_vertices, adj_offsets, adj_nbrs);
+                }
+                else
+                {
+                    const uint64_t* entries = adj_edges;
+                    compressed.build(num_vertices, adj_offsets, adj_nbrs, [entries](const uint64_t k)
+                    {
+                        return (entries[k] & SNAP_ADJ_IN_ENTRY) == 0;
+                    });
+                    compressed_in.build(num_vertices, adj_offsets, adj_nbrs, [entries](const uint64_t k)
+                    {
+                        return (entries[k] & SNAP_ADJ_IN_ENTRY) != 0;
+                    });
+                }
+            }
+            catch(...)
+            {
+                close();
+                throw;
+            }
+            compressed_mode = true;
+            adviseAdjacency(ACCESS_DONTNEED);
+            file.advise(reader->info().section_offset[SNAP_ADJ_EDGES], reader->bytes(SNAP_ADJ_EDGES), ACCESS_DONTNEED);
+        }
+        // the checks above read the file front to back; from now on the adjacency is read in frontier order
+        file.advise(0, file.size(), ACCESS_NORMAL);
+        return true;
+    }
+
+    // unmaps the snapshot and releases the in-memory indexes
+    void close()
+    {
+        delete reader;
+        reader = nullptr;
+        file.close();
+        num_vertices = 0;
+        num_edges = 0;
+        v_ids = nullptr;
+        e_ids = nullptr;
+        adj_offsets = nullptr;
+        adj_edges = nullptr;
+        adj_nbrs = nullptr;
+        dense_ids = true;
+        directed = false;
+        compressed_mode = false;
+        compressed.clear();
+        compressed_in.clear();
+        vertex_map.clear();
+        conn_index.reset(0);
+        conn_index_built = false;
+        search_stamp = MyVector<unsigned long long>(0);
+        search_dist = MyVector<long long>(0);
+        search_epoch = 0;
+        return;
+    }
+
+    // returns the number of vertices in the graph
+    size_t numVertices(void) const
+    {
+        return num_vertices;
+    }
+
+    // returns the number of edges in the graph
+    size_t numEdges(void) const
+    {
+        return num_edges;
+    }
+
+    // checks whether the graph is empty (no vertex)
+    bool empty(void) const
+    {
+        return (num_vertices == 0);
+    }
+
+    // returns the number of edges incident to vid (a self-loop counts twice; in directed graphs, incoming and outgoing)
+    size_t degree(const VertexIDType vid) const
+    {
+        return rowLength(vertexID2SetPos(vid));
+    }
+
+    // returns the bytes held in memory by the view: the compressed adjacency, the ID map, the connectivity index
+    // and the marks of the point-to-point searches (the mapped file is not counted; its pages belong to the page cache)
+    size_t memoryUsage(void) const
+    {
+        return sizeof(*this) + compressed.memoryUsage() + compressed_in.memoryUsage() + vertex_map.memoryUsage() + conn_index.memoryUsage()
+               + search_stamp.memoryUsage() + search_dist.memoryUsage();
+    }
+
+    // returns a copy of the property of vertex vid
+    VertexDataType vertexData(const VertexIDType vid) const
+    {
+        VertexDataType out;
+        MySnapshotCodec<VertexDataType>::read(reader->array<char>(SNAP_VERTEX_DATA), reader->array<char>(SNAP_VERTEX_BLOB),
+                                              reader->bytes(SNAP_VERTEX_BLOB), vertexID2SetPos(vid), out);
+        return out;
+    }
+
+    // looks for an edge between sid and tid (from sid to tid in directed graphs) by scanning the shorter of their adjacency ranges
+    // if found, stores its ID in eid and returns true (as MyGraph::probeEdge, sid must exist and a missing tid gives false;
+    // of parallel edges, the one with the smallest ID is returned)
+    bool probeEdge(const VertexIDType sid, const VertexIDType tid, EdgeIDType& eid) const
+    {
+        size_t pos_s = vertexID2SetPos(sid);
+        size_t pos_x;
+        if(!findPos(tid, pos_x))
+        {
+            return false;
+        }
+        // the edges from sid to tid are the outgoing entries of sid's row and the incoming entries of tid's row
+        StepDirection dir = STEP_OUT;
+        if(adj_offsets[pos_s + 1] - adj_offsets[pos_s] > adj_offsets[pos_x + 1] - adj_offsets[pos_x])
+        {
+            std::swap(pos_s, pos_x);
+            dir = STEP_IN;
+        }
+        bool found = false;
+        for(uint64_t k = adj_offsets[pos_s]; k < adj_offsets[pos_s + 1]; ++ k)
+        {
+            if(adj_nbrs[k] == pos_x && entryLeads(k, dir) && (!found || e_ids[entryEdge(k)] < eid))
+            {
+                eid = e_ids[entryEdge(k)];
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    // performs breath-first-search on the graph, starting from v_src (see MyGraph::breadthFirstSearch)
+    // with BFS_EDGE_ID_ORDER, the path is the one MyGraph produces
+    // with BFS_DIRECTION_OPTIMIZING, the path is ordered by level; each level is sorted by position,
+    // so the next level reads the adjacency in ascending file order
+    void breadthFirstSearch(const VertexIDType v_src, MyVector<VertexIDType>& path, const BFSMode mode = BFS_DIRECTION_OPTIMIZING)
+    {
+        MYGRAPH_SPAN("MyGraphView", "breadthFirstSearch");
+        size_t pos_src = vertexID2SetPos(v_src);
+        if(mode == BFS_DIRECTION_OPTIMIZING)
+        {
+            directionOptimizingBFS(pos_src, path);
+            return;
+        }
+        path.resize(0);
+        MyBitmap visited(num_vertices);
+        MyQueue<size_t> queue;
+        MyVector<std::pair<EdgeIDType, size_t> > edges;
+        visited.set(pos_src);
+        queue.enqueue(pos_src);
+        while(!queue.empty())
+        {
+            size_t u = queue.front();
+            queue.dequeue();
+            path.push_back(v_ids[u]);
+            sortedEdges(u, STEP_OUT, edges);
+            for(size_t i = 0; i < edges.size(); ++ i)
+            {
+                size_t w = edges[i].second;
+                if(!visited.test(w))
+                {
+                    visited.set(w);
+                    queue.enqueue(w);
+                }
+            }
+        }
+        return;
+    }
+
+    // performs depth-first-search on the graph, starting from v_src (see MyGraph::depthFirstSearch)
+    // the path is the one MyGraph produces
+    void depthFirstSearch(const VertexIDType v_src, MyVector<VertexIDType>& path)
+    {
+        MYGRAPH_SPAN("MyGraphView", "depthFirstSearch");
+        size_t pos_src = vertexID2SetPos(v_src);
+        path.resize(0);
+        MyBitmap visited(num_vertices);
+        MyStack<size_t> stack;
+        MyVector<std::pair<EdgeIDType, size_t> > edges;
+        stack.push(pos_src);
+        while(!stack.empty())
+        {
+            size_t u = stack.top();
+            stack.pop();
+            if(visited.test(u))
+            {
+                continue;
+            }
+            visited.set(u);
+            path.push_back(v_ids[u]);
+            sortedEdges(u, STEP_OUT, edges);
+            for(size_t i = edges.size(); i > 0; -- i)
+            {
+                if(!visited.test(edges[i - 1].second))
+                {
+                    stack.push(edges[i - 1].second);
+                }
+            }
+        }
+        return;
+    }
+
+    // determines whether vid1 and vid2 are connected (weakly, in directed graphs)
+    // the first call builds the connectivity index in one sequential pass over the adjacency;
+    // later calls take O(alpha(n))
+    bool isConnected(const VertexIDType vid1, const VertexIDType vid2)
+    {
+        MYGRAPH_SPAN("MyGraphView", "isConnected");
+        size_t pos_1 = vertexID2SetPos(vid1);
+        size_t pos_2 = vertexID2SetPos(vid2);
+        ensureConnIndex();
+        return conn_index.connected(pos_1, pos_2);
+    }
+
+    // returns the number of edges on a shortest path between vid1 and vid2 (from vid1 to vid2 in directed graphs)
+    // returns -1 if there is no such path
+    // runs a bidirectional BFS that always expands the smaller frontier; the visit marks are kept between calls,
+    // so only the first call allocates O(n) memory and later ones touch just the vertices they reach
+    long long hopDistance(const VertexIDType vid1, const VertexIDType vid2)
+    {
+        MYGRAPH_SPAN("MyGraphView", "hopDistance");
+        size_t pos_1 = vertexID2SetPos(vid1);
+        size_t pos_2 = vertexID2SetPos(vid2);
+        if(conn_index_built && !conn_index.connected(pos_1, pos_2))
+        {
+            return -1;
+        }
+        return bidirectionalSearch(pos_1, pos_2);
+    }
+
+    // returns an identifier of the connected component containing vid (weakly connected, in directed graphs)
+    // two vertices are connected iff they have the same component ID
+    size_t componentId(const VertexIDType vid)
+    {
+        size_t pos = vertexID2SetPos(vid);
+        ensureConnIndex();
+        return conn_index.find(pos);
+    }
+
+    // returns the number of connected components in the graph
+    size_t numComponents(void)
+    {
+        ensureConnIndex();
+        return conn_index.numSets();
+    }
+
+  private:
+    MyMappedFile file;                  // the mapped snapshot
+    MySnapshotReader* reader;           // the validated sections of file (nullptr while closed)
+    size_t num_vertices;
+    size_t num_edges;
+    const int64_t* v_ids;               // the vertex IDs by position
+    const int64_t* e_ids;               // the edge IDs by position
+    const uint64_t* adj_offsets;        // the CSR row offsets (n + 1)
+    const uint64_t* adj_edges;          // the edge position of each adjacency entry (2m)
+    const uint64_t* adj_nbrs;           // the neighbour position of each adjacency entry (2m)
+    bool dense_ids;                     // whether the vertex at position i has ID i + 1 (vertex_map is unused then)
+    bool directed;                      // whether the snapshot was written by a directed graph
+    bool compressed_mode;               // whether the neighbour-only queries read compressed (opened with VIEW_COMPRESSED)
+    MyCompressedAdjacency compressed;   // the neighbour lists (empty unless compressed_mode; only the outgoing ones if directed)
+    MyCompressedAdjacency compressed_in;    // the incoming neighbour lists (empty unless compressed_mode and directed)
+    MyIDMap vertex_map;                 // the mapping between a vertex ID and its position, if the IDs are not dense
+    MyDisjointSet conn_index;           // the connected components over the positions
+    bool conn_index_built;              // whether conn_index has been built
+    MyVector<unsigned long long> search_stamp;      // per-position visit marks of the point-to-point searches
+    MyVector<long long> search_dist;                // per-position hop distances of the point-to-point searches
+    unsigned long long search_epoch;                // the number of point-to-point searches started so far
+
+    // the directions a traversal step can take along an edge (they differ only in directed snapshots)
+    enum StepDirection
+    {
+        STEP_OUT,       // from the source to the target
+        STEP_IN,        // from the target to the source
+        STEP_ANY        // either way
+    };
+
+    // retrieves the position of the vertex vid in the snapshot
+    // returns true if vid exists, false otherwise
+    bool findPos(const VertexIDType vid, size_t& pos) const
+    {
+        if(dense_ids)
+        {
+            if(vid <= 0 || static_cast<size_t>(vid) > num_vertices)
+            {
+                return false;
+            }
+            pos = static_cast<size_t>(vid - 1);
+            return true;
+        }
+        return vertex_map.get(vid, pos);
+    }
+
+    // maps the vertex ID to its position in the snapshot
+    size_t vertexID2SetPos(const VertexIDType vid) const
+    {
+        size_t pos;
+        if(!findPos(vid, pos))
+        {
+            throw std::out_of_range("MyGraphView vertexID2SetPos: vertex ID not found");
+        }
+        return pos;
+    }
+
+    // hints the kernel how the adjacency (offsets and neighbour entries, and the direction flags if directed)
+    // is about to be read (the neighbour-only queries do not read it in compressed mode)
+    void adviseAdjacency(const MyAccessHint hint) const
+    {
+        if(compressed_mode && hint != ACCESS_DONTNEED)
+        {
+            return;
+        }
+        file.advise(reader->info().section_offset[SNAP_ADJ_OFFSETS], reader->bytes(SNAP_ADJ_OFFSETS), hint);
+        file.advise(reader->info().section_offset[SNAP_ADJ_NEIGHBORS], reader->bytes(SNAP_ADJ_NEIGHBORS), hint);
+        if(directed)
+        {
+            file.advise(reader->info().section_offset[SNAP_ADJ_EDGES], reader->bytes(SNAP_ADJ_EDGES), hint);
+        }
+        return;
+    }
+
+    // returns the edge position of the adjacency entry k
+    size_t entryEdge(const uint64_t k) const
+    {
+        return static_cast<size_t>(MySnapshotReader::entryEdge(adj_edges[k]));
+    }
+
+    // checks whether a step in direction dir may use the adjacency entry k (always true in undirected snapshots)
+    bool entryLeads(const uint64_t k, const StepDirection dir) const
+    {
+        return !directed || dir == STEP_ANY || ((adj_edges[k] & SNAP_ADJ_IN_ENTRY) == 0) == (dir == STEP_OUT);
+    }
+
+    // returns the number of adjacency entries of the vertex at pos_u
+    size_t rowLength(const size_t pos_u) const
+    {
+        if(compressed_mode)
+        {
+            return compressed.degree(pos_u) + (directed ? compressed_in.degree(pos_u) : 0);
+        }
+        return static_cast<size_t>(adj_offsets[pos_u + 1] - adj_offsets[pos_u]);
+    }
+
+    // calls func(w) for the neighbour positions w a step in direction dir leads to from the vertex at pos_u,
+    // until it returns false (in file order, or ascending per list in compressed mode); returns false if func stopped
+    template <typename FuncType>
+    bool forEachNeighbor(const size_t pos_u, const StepDirection dir, FuncType func) const
+    {
+        if(compressed_mode)
+        {
+            if(!directed)
+            {
+                return compressed.forEachNeighbor(pos_u, func);
+            }
+            return (dir == STEP_IN || compressed.forEachNeighbor(pos_u, func))
+                   && (dir == STEP_OUT || compressed_in.forEachNeighbor(pos_u, func));
+        }
+        for(uint64_t k = adj_offsets[pos_u]; k < adj_offsets[pos_u + 1]; ++ k)
+        {
+            if(entryLeads(k, dir) && !func(static_cast<size_t>(adj_nbrs[k])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // collects the (edge ID, neighbour position) pairs a step in direction dir may take from the vertex at pos_u,
+    // in ascending edge ID order
+    void sortedEdges(const size_t pos_u, const StepDirection dir, MyVector<std::pair<EdgeIDType, size_t> >& edges) const
+    {
+        edges.resize(0);
+        for(uint64_t k = adj_offsets[pos_u]; k < adj_offsets[pos_u + 1]; ++ k)
+        {
+            if(entryLeads(k, dir))
+            {
+                edges.push_back(std::pair<EdgeIDType, size_t>(e_ids[entryEdge(k)], adj_nbrs[k]));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        return;
+    }
+
+    // builds conn_index from one sequential pass over the adjacency
+    void ensureConnIndex(void)
+    {
+        if(conn_index_built)
+        {
+            return;
+        }
+        MYGRAPH_SPAN("MyGraphView", "buildConnectivityIndex");
+        adviseAdjacency(ACCESS_SEQUENTIAL);
+        conn_index.reset(num_vertices);
+        for(size_t u = 0; u < num_vertices; ++ u)
+        {
+            forEachNeighbor(u, STEP_ANY, [&](const size_t w)
+            {
+                if(w > u)
+                {
+                    conn_index.unite(u, w);
+                }
+                return true;
+            });
+        }
+        adviseAdjacency(ACCESS_NORMAL);
+        conn_index_built = true;
+        return;
+    }
+
+    // direction-optimizing BFS from the position pos_src (see MyGraph::directionOptimizingBFS)
+    // top-down steps read the rows of the (sorted) frontier in ascending file order with read-ahead off;
+    // bottom-up steps scan the rows of all unvisited vertices front to back with read-ahead on
+    void directionOptimizingBFS(const size_t pos_src, MyVector<VertexIDType>& path)
+    {
+        const size_t BFS_ALPHA = 14;
+        const size_t BFS_BETA = 24;
+        size_t n = num_vertices;
+        MyBitmap visited(n);
+        MyBitmap in_frontier(n);
+        MyVector<size_t> frontier;
+        MyVector<size_t> next;
+
+        path.resize(0);
+        path.reserve(n);
+        visited.set(pos_src);
+        frontier.push_back(pos_src);
+        path.push_back(v_ids[pos_src]);
+        size_t edges_frontier = rowLength(pos_src);
+        size_t edges_unexplored = 2 * num_edges - edges_frontier;
+        bool bottom_up = false;
+        adviseAdjacency(ACCESS_RANDOM);
+        while(!frontier.empty())
+        {
+            if(!bottom_up && edges_frontier > edges_unexplored / BFS_ALPHA)
+            {
+                bottom_up = true;
+                adviseAdjacency(ACCESS_SEQUENTIAL);
+            }
+            else if(bottom_up && frontier.size() < n / BFS_BETA && frontier.size() < next.size())
+            {
+                bottom_up = false;
+                adviseAdjacency(ACCESS_RANDOM);
+            }
+
+            next.resize(0);
+            if(!bottom_up)
+            {
+                for(size_t i = 0; i < frontier.size(); ++ i)
+                {
+                    forEachNeighbor(frontier[i], STEP_OUT, [&](const size_t w)
+                    {
+                        if(!visited.test(w))
+                        {
+                            visited.set(w);
+                            next.push_back(w);
+                        }
+                        return true;
+                    });
+                }
+                std::sort(next.begin(), next.end());
+            }
+            else
+            {
+                for(size_t i = 0; i < frontier.size(); ++ i)
+                {
+                    in_frontier.set(frontier[i]);
+                }
+                // the unvisited vertices come out in ascending order, so next needs no sorting
+                for(size_t wd = 0; wd < visited.numWords(); ++ wd)
+                {
+                    unsigned long long unvisited = ~visited.word(wd);
+                    while(unvisited != 0)
+                    {
+                        size_t w = 64 * wd + __builtin_ctzll(unvisited);
+                        unvisited &= unvisited - 1;
+                        if(w >= n)
+                        {
+                            break;
+                        }
+                        bool found = !forEachNeighbor(w, STEP_IN, [&](const size_t x)
+                        {
+                            return !in_frontier.test(x);
+                        });
+                        if(found)
+                        {
+                            visited.set(w);
+                            next.push_back(w);
+                        }
+                    }
+                }
+                for(size_t i = 0; i < frontier.size(); ++ i)
+                {
+                    in_frontier.reset(frontier[i]);
+                }
+            }
+
+            edges_frontier = 0;
+            for(size_t i = 0; i < next.size(); ++ i)
+            {
+                path.push_back(v_ids[next[i]]);
+                edges_frontier += rowLength(next[i]);
+            }
+            edges_unexplored -= edges_frontier;
+            std::swap(frontier, next);
+        }
+        adviseAdjacency(ACCESS_NORMAL);
+        return;
+    }
+
+    // starts a new search over search_stamp/search_dist (see MyGraph::beginSearch)
+    // the arrays are allocated and cleared by the first search only; later stamps compare below the returned base
+    unsigned long long beginSearch(void)
+    {
+        if(search_stamp.size() < num_vertices)
+        {
+            MyVector<unsigned long long> stamps(num_vertices);
+            MyVector<long long> dists(num_vertices);
+            for(size_t i = 0; i < num_vertices; ++ i)
+            {
+                stamps[i] = 0;
+            }
+            search_stamp = std::move(stamps);
+            search_dist = std::move(dists);
+        }
+        ++ search_epoch;
+        return 2 * search_epoch;
+    }
+
+    // bidirectional BFS between the positions pos_1 and pos_2 (see MyGraph::bidirectionalSearch)
+    // every level is sorted by position before it is expanded
+    // in directed snapshots, searches for a path from pos_1 to pos_2 (the pos_2 side walks edges backwards)
+    // returns the hop distance, or -1 if there is no such path
+    long long bidirectionalSearch(const size_t pos_1, const size_t pos_2)
+    {
+        if(pos_1 == pos_2)
+        {
+            return 0;
+        }
+        // search_stamp[v]: base if reached from pos_1, base + 1 if reached from pos_2, lower if unvisited
+        const StepDirection dir[2] = { STEP_OUT, STEP_IN };
+        unsigned long long base = beginSearch();
+        MyVector<size_t> frontier[2];
+        MyVector<size_t> next;
+        search_stamp[pos_1] = base;
+        search_stamp[pos_2] = base + 1;
+        search_dist[pos_1] = 0;
+        search_dist[pos_2] = 0;
+        frontier[0].push_back(pos_1);
+        frontier[1].push_back(pos_2);
+        while(!frontier[0].empty() && !frontier[1].empty())
+        {
+            size_t side = (frontier[0].size() <= frontier[1].size() ? 0 : 1);
+            long long best = -1;
+            next.resize(0);
+            for(size_t i = 0; i < frontier[side].size(); ++ i)
+            {
+                size_t u = frontier[side][i];
+                forEachNeighbor(u, dir[side], [&](const size_t w)
+                {
+                    if(search_stamp[w] == base + 1 - side)
+                    {
+                        long long d = search_dist[u] + 1 + search_dist[w];
+                        if(best < 0 || d < best)
+                        {
+                            best = d;
+                        }
+                    }
+                    else if(search_stamp[w] != base + side)
+                    {
+                        search_stamp[w] = base + side;
+                        search_dist[w] = search_dist[u] + 1;
+                        next.push_back(w);
+                    }
+                    return true;
+                });
+            }
+            if(best >= 0)
+            {
+                return best;
+            }
+            std::sort(next.begin(), next.end());
+            std::swap(frontier[side], next);
+        }
+        return -1;
+    }
+};
+
+#endif // __MYGRAPHVIEW_H__
@@ -3,26 +3,171 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <utility>
 
 #include "MyVector_c336t319.h"
 #include "MyLinkedList_c336t319.h"
 #include "MyQueue_c336t319.h"
 #include "MyStack_c336t319.h"
 #include "MyHashTable_c336t319.h"
+#include "MyIDMap_c336t319.h"
+#include "MyDisjointSet_c336t319.h"
+#include "MyBitmap_c336t319.h"
+#include "MyThreadPool_c336t319.h"
+#include "MySetIntersection_c336t319.h"
+#include "MyTrace_c336t319.h"
+#include "MyMemory_c336t319.h"
+#include "MyGraphPolicy_c336t319.h"
+#include "MyMappedFile_c336t319.h"
+#include "MySnapshot_c336t319.h"
 
 
-// the graph is supposed to be a undirected graph
+// the graph is supposed to be a undirected graph (a directed one with MyDirectedPolicy, see MyGraphPolicy_c336t319.h)
 // no multi-edge is allowed (assumed to be ensured from the input)
 
 typedef long long VertexIDType;
 typedef long long EdgeIDType;
+typedef std::pair<VertexIDType, VertexIDType> EdgeKeyType;   // the unordered endpoint pair of an edge, stored as (min, max)
+                                                            // (the ordered pair (src, tgt) in directed graphs)
 
+// an adjacency list entry of a MyGraph with inline neighbours (MyGraphPolicy<..., true>);
+// the entries of the other graphs are plain edge IDs
+struct MyNeighborEntry
+{
+    EdgeIDType eid;         // the edge
+    VertexIDType nbr;       // the ID of the other end of the edge
+    bool out;               // whether the edge leaves the vertex owning the list (always true in undirected graphs)
+};
+
+// the adjacency list entry type of a MyGraph
+template <bool InlineNeighbors>
+struct MyAdjacencyEntry
+{
+    typedef EdgeIDType Type;
+};
+
+template <>
+struct MyAdjacencyEntry<true>
+{
+    typedef MyNeighborEntry Type;
+};
+
+// the traversal strategies supported by MyGraph::breadthFirstSearch
+enum BFSMode
+{
+    BFS_DIRECTION_OPTIMIZING,   // switches between top-down and bottom-up steps based on frontier edge counts
+    BFS_EDGE_ID_ORDER           // visits the edges of each vertex in ascending ID order (deterministic path)
+};
+
+// the vertex orderings supported by MyGraph::reorder
+enum ReorderStrategy
+{
+    REORDER_RCM,                // reverse Cuthill-McKee: each component from a pseudo-peripheral vertex, neighbours by ascending degree,
+                                // reversed at the end; keeps adjacent vertices within a narrow band of positions
+    REORDER_DEGREE_DESCENDING,  // the highest degrees first: the most visited vertices and lists share the first cache lines
+    REORDER_BFS                 // breadth-first from the highest-degree vertex of each component: every neighbourhood lands close together
+};
+
+// the algorithms supported by MyGraph::minimumSpanningForest
+enum MSFAlgorithm
+{
+    MSF_BORUVKA,                // rounds in which every component picks its lightest outgoing edge; the edge array is scanned in parallel
+    MSF_FILTER_KRUSKAL          // Kruskal on the lighter part of a pivot partition first, then on the rest of the edges minus
+                                // those the forest already connects; partitions and filters run in parallel
+};
+
+// receives every mutation of a MyGraph it is attached to (see MyGraph::setLog), after the mutation succeeded
+// batch deletions are reported as one call, so replaying them reproduces the same element order;
+// implemented by MyGraphLog (MyGraphLog_c336t319.h)
 template <typename VertexDataType, typename EdgeDataType>
+class MyGraphLogSink
+{
+  public:
+    virtual ~MyGraphLogSink()
+    {
+    }
+
+    virtual void logAddVertex(const VertexIDType vid, const VertexDataType& v_data) = 0;
+    virtual void logAddEdge(const EdgeIDType eid, const VertexIDType sid, const VertexIDType tid, const EdgeDataType& e_data) = 0;
+    virtual void logDeleteVertex(const VertexIDType vid) = 0;
+    virtual void logDeleteEdge(const EdgeIDType eid) = 0;
+    virtual void logDeleteVertices(const MyVector<VertexIDType>& vids) = 0;
+    virtual void logDeleteEdges(const MyVector<EdgeIDType>& eids) = 0;
+
+    // called once a mutation and all of its records are complete (the graph is consistent again)
+    virtual void logCommit()
+    {
+    }
+};
+
+// an edge to be added by MyGraph::addEdges: the IDs of its two end vertices and its property
+// the property is held in a base class, so an empty one (MyNoData) takes no space
+template <typename EdgeDataType>
+class MyEdgeRecord : public MyPropertyHolder<EdgeDataType>
+{
+  public:
+    // default constructor
+    MyEdgeRecord()
+    {
+        return;
+    }
+
+    // constructor for an edge without a property (the default-constructed EdgeDataType)
+    // sid: source vertex ID; vid: target vertex ID
+    MyEdgeRecord(const VertexIDType sid, const VertexIDType tid) :
+        MyPropertyHolder<EdgeDataType>(EdgeDataType()),
+        src(sid),
+        tgt(tid)
+    {
+        return;
+    }
+
+    // copy constructor
+    // sid: source vertex ID; vid: target vertex ID
+    MyEdgeRecord(const VertexIDType sid, const VertexIDType tid, const EdgeDataType& edge_data) :
+        MyPropertyHolder<EdgeDataType>(edge_data),
+        src(sid),
+        tgt(tid)
+    {
+        return;
+    }
+
+    // move constructor
+    // sid: source vertex ID; vid: target vertex ID
+    MyEdgeRecord(const VertexIDType sid, const VertexIDType tid, EdgeDataType && edge_data) :
+        MyPropertyHolder<EdgeDataType>(std::move(edge_data)),
+        src(sid),
+        tgt(tid)
+    {
+        return;
+    }
+
+    VertexIDType src, tgt;  // the IDs for the source vertex and the target vertex of the edge
+};
+
+template <typename VertexDataType, typename EdgeDataType, typename GraphPolicy = MyUndirectedPolicy>
+class MyGraphLog;
+
+template <typename VertexDataType, typename EdgeDataType, typename GraphPolicy = MyUndirectedPolicy>
+class MyGraphColumns;
+
+template <typename VertexDataType, typename EdgeDataType, typename GraphPolicy = MyUndirectedPolicy>
+class MyGraphMatrix;
+
+template <typename VertexDataType, typename EdgeDataType, typename GraphPolicy = MyUndirectedPolicy>
 class MyGraph
 {
+  private:
+    typedef typename MyAdjacencyEntry<GraphPolicy::inline_neighbors>::Type AdjEntryType;    // the element of the adjacency lists
+    typedef MyLinkedList<AdjEntryType> AdjListType;
+
   public:
 
-    class Vertex
+    class Vertex : public MyCountedObject
     {
       public: 
         // default constructor
@@ -71,7 +216,7 @@ class MyGraph
 
     };
 
-    class Edge
+    class Edge : public MyCountedObject
     {
       public:
         // default constructor
@@ -108,6 +253,8 @@ class MyGraph
             tgt = rhs.tgt;
             tag = rhs.tag;
             data = rhs.data;
+            src_itr = rhs.src_itr;
+            tgt_itr = rhs.tgt_itr;
             return *this;
         }
 
@@ -119,6 +266,8 @@ class MyGraph
             tgt = rhs.tgt;
             tag = rhs.tag;
             data = std::move(rhs.data);
+            src_itr = rhs.src_itr;
+            tgt_itr = rhs.tgt_itr;
             return *this;
         }
       
@@ -127,10 +276,17 @@ class MyGraph
         int tag;                // the reserved tag varaible
         EdgeDataType data;      // the property associated with the edge
 
+      private:
+        typename AdjListType::iterator src_itr;     // the node of this edge in the source vertex's adjacency list
+        typename AdjListType::iterator tgt_itr;     // the node of this edge in the target vertex's adjacency list
+
         friend class MyGraph;
 
     };
 
+    // an edge to be added by addEdges (shared by all graph policies)
+    typedef MyEdgeRecord<EdgeDataType> EdgeRecord;
+
     // default constructor of graph
     // initialize the graph with a size of 0
     MyGraph() :
@@ -140,9 +296,25 @@ class MyGraph
         num_edges(0),
         vertex_set(0),
         edge_set(0),
-        vertex_map{},
-        edge_map{},
-        adj_list()
+        vertex_map(),
+        edge_map(),
+        adj_list(),
+        edge_index{},
+        adj_matrix(0),
+        adj_matrix_dim(0),
+        adj_matrix_enabled(false),
+        adj_matrix_dirty(true),
+        conn_index(0),
+        conn_index_dirty(false),
+        conn_index_enabled(true),
+        search_stamp(0),
+        search_dist(0),
+        search_epoch(0),
+        cnt_vertex_lookups(0),
+        cnt_edge_lookups(0),
+        cnt_traversal_vertices(0),
+        cnt_traversal_edges(0),
+        mutation_log(nullptr)
     {   
         return;
     }
@@ -173,15 +345,29 @@ class MyGraph
     VertexIDType addVertex(const VertexDataType& v_data)
     {
         // code begins
-        VertexIDType vid = ++current_vertex_ID;
+        MYGRAPH_SPAN("MyGraph", "addVertex");
+        VertexIDType vid = nextVertexID();
         Vertex* v = new Vertex(v_data);
         v->id = vid;
         v->tag = 0;
         vertex_set.push_back(v);
         size_t pos = vertex_set.size() -1;
-        vertex_map.insert(HashedObj<VertexIDType,size_t>(vid, pos));
-        adj_list.push_back(new MyLinkedList<EdgeIDType>());
+        vertex_map.insert(vid, pos);
+        adj_list.push_back(new AdjListType());
+        if(pos >= adj_matrix_dim)
+        {
+            adj_matrix_dirty = true;
+        }
+        if(!conn_index_dirty)
+        {
+            conn_index.makeSet();
+        }
         ++num_vertices;
+        if(mutation_log != nullptr)
+        {
+            mutation_log->logAddVertex(vid, v->data);
+            mutation_log->logCommit();
+        }
         return vid;
         // code ends
     }
@@ -193,19 +379,63 @@ class MyGraph
     VertexIDType addVertex(VertexDataType && v_data)
     {
         // code begins
-        VertexIDType vid = ++current_vertex_ID;
+        MYGRAPH_SPAN("MyGraph", "addVertex");
+        VertexIDType vid = nextVertexID();
         Vertex* v = new Vertex(std::move(v_data));
         v->id = vid;
         v->tag = 0;
         vertex_set.push_back(v);
         size_t pos = vertex_set.size() -1;
-        vertex_map.insert(HashedObj<VertexIDType,size_t>(vid, pos));
-        adj_list.push_back(new MyLinkedList<EdgeIDType>());
+        vertex_map.insert(vid, pos);
+        adj_list.push_back(new AdjListType());
+        if(pos >= adj_matrix_dim)
+        {
+            adj_matrix_dirty = true;
+        }
+        if(!conn_index_dirty)
+        {
+            conn_index.makeSet();
+        }
         ++num_vertices;
+        if(mutation_log != nullptr)
+        {
+            mutation_log->logAddVertex(vid, v->data);
+            mutation_log->logCommit();
+        }
         return vid;
         // code ends
     }
 
+    // adds the vertices in v_data to the graph (copy)
+    // the vertices get the consecutive IDs first, first+1, ..., in the order of v_data
+    // sizes every structure once up front instead of growing it per vertex
+    // returns the ID first assigned to v_data[0]
+    VertexIDType addVertices(const MyVector<VertexDataType>& v_data)
+    {
+        MYGRAPH_SPAN("MyGraph", "addVertices");
+        size_t base = reserveVertices(v_data.size());
+        for(size_t i = 0; i < v_data.size(); ++ i)
+        {
+            vertex_set.push_back(new Vertex(v_data[i]));
+        }
+        return indexNewVertices(base);
+    }
+
+    // adds the vertices in v_data to the graph (move)
+    // the vertices get the consecutive IDs first, first+1, ..., in the order of v_data
+    // sizes every structure once up front instead of growing it per vertex
+    // returns the ID first assigned to v_data[0]
+    VertexIDType addVertices(MyVector<VertexDataType> && v_data)
+    {
+        MYGRAPH_SPAN("MyGraph", "addVertices");
+        size_t base = reserveVertices(v_data.size());
+        for(size_t i = 0; i < v_data.size(); ++ i)
+        {
+            vertex_set.push_back(new Vertex(std::move(v_data[i])));
+        }
+        return indexNewVertices(base);
+    }
+
     // retrieves the information of the vertex specified by the vid
     // returns the vertex
     Vertex* getVertex(const VertexIDType vid)
@@ -224,21 +454,37 @@ class MyGraph
     EdgeIDType addEdge(const VertexIDType sid, const VertexIDType tid, const EdgeDataType& e_data)
     {
         // code begins
-        EdgeIDType eid = ++current_edge_ID;
+        MYGRAPH_SPAN("MyGraph", "addEdge");
+        // look up both ends first: a missing vertex must not leave a half-linked edge behind
+        size_t pos_s = vertexID2SetPos(sid);
+        size_t pos_x = vertexID2SetPos(tid);
+        EdgeIDType eid = nextEdgeID();
         Edge* e = new Edge(sid, tid, e_data);
         e->id = eid;
         e->tag = 0;
         
         edge_set.push_back(e);
         size_t pos = edge_set.size() -1;
-        edge_map.insert(HashedObj<VertexIDType,size_t>(eid, pos));
+        edge_map.insert(eid, pos);
         
-        size_t pos_s = vertexID2SetPos(sid);
-        size_t pos_x = vertexID2SetPos(tid);
-        adj_list[pos_s] -> push_back(eid);
-        adj_list[pos_x] -> push_back(eid);
+        e->src_itr = adj_list[pos_s] -> insert(adj_list[pos_s] -> end(), makeEntry(e, true));
+        e->tgt_itr = adj_list[pos_x] -> insert(adj_list[pos_x] -> end(), makeEntry(e, false));
+        edge_index.insert(HashedObj<EdgeKeyType,EdgeIDType>(edgeKey(sid, tid), eid));
+        if(!adj_matrix_dirty)
+        {
+            markAdjacent(pos_s, pos_x);
+        }
+        if(!conn_index_dirty)
+        {
+            conn_index.unite(pos_s, pos_x);
+        }
 
         ++num_edges;
+        if(mutation_log != nullptr)
+        {
+            mutation_log->logAddEdge(eid, sid, tid, e->data);
+            mutation_log->logCommit();
+        }
         return eid;
         // code ends
     }
@@ -251,25 +497,84 @@ class MyGraph
     EdgeIDType addEdge(const VertexIDType sid, const VertexIDType tid, EdgeDataType && e_data)
     {
         // code begins
-        EdgeIDType eid = ++current_edge_ID;
+        MYGRAPH_SPAN("MyGraph", "addEdge");
+        // look up both ends first: a missing vertex must not leave a half-linked edge behind
+        size_t pos_s = vertexID2SetPos(sid);
+        size_t pos_x = vertexID2SetPos(tid);
+        EdgeIDType eid = nextEdgeID();
         Edge* e = new Edge(sid, tid, std::move(e_data));
         e->id = eid;
         e->tag = 0;
         
         edge_set.push_back(e);
         size_t pos = edge_set.size() -1;
-        edge_map.insert(HashedObj<VertexIDType,size_t>(eid, pos));
+        edge_map.insert(eid, pos);
         
-        size_t pos_s = vertexID2SetPos(sid);
-        size_t pos_x = vertexID2SetPos(tid);
-        adj_list[pos_s] -> push_back(eid);
-        adj_list[pos_x] -> push_back(eid);
+        e->src_itr = adj_list[pos_s] -> insert(adj_list[pos_s] -> end(), makeEntry(e, true));
+        e->tgt_itr = adj_list[pos_x] -> insert(adj_list[pos_x] -> end(), makeEntry(e, false));
+        edge_index.insert(HashedObj<EdgeKeyType,EdgeIDType>(edgeKey(sid, tid), eid));
+        if(!adj_matrix_dirty)
+        {
+            markAdjacent(pos_s, pos_x);
+        }
+        if(!conn_index_dirty)
+        {
+            conn_index.unite(pos_s, pos_x);
+        }
 
         ++num_edges;
+        if(mutation_log != nullptr)
+        {
+            mutation_log->logAddEdge(eid, sid, tid, e->data);
+            mutation_log->logCommit();
+        }
         return eid;
         // code ends
     }
 
+    // adds an edge between sid and tid with the default-constructed property (for graphs without edge data, e.g. MyNoData)
+    // returns the assigned edge ID
+    EdgeIDType addEdge(const VertexIDType sid, const VertexIDType tid)
+    {
+        return addEdge(sid, tid, EdgeDataType());
+    }
+
+    // adds the edges in e_data to the graph (copy)
+    // the edges get the consecutive IDs first, first+1, ..., in the order of e_data
+    // sizes every structure once up front, then links the adjacency lists in a counting-sort pass
+    // (each list receives its new edges in ascending ID order, as with repeated addEdge calls)
+    // throws before modifying the graph if an end vertex does not exist
+    // returns the ID first assigned to e_data[0]
+    EdgeIDType addEdges(const MyVector<EdgeRecord>& e_data)
+    {
+        MYGRAPH_SPAN("MyGraph", "addEdges");
+        MyVector<size_t> end_pos;
+        size_t base = reserveEdges(e_data, end_pos);
+        for(size_t i = 0; i < e_data.size(); ++ i)
+        {
+            edge_set.push_back(new Edge(e_data[i].src, e_data[i].tgt, e_data[i].data));
+        }
+        return linkNewEdges(base, end_pos);
+    }
+
+    // adds the edges in e_data to the graph (move)
+    // the edges get the consecutive IDs first, first+1, ..., in the order of e_data
+    // sizes every structure once up front, then links the adjacency lists in a counting-sort pass
+    // (each list receives its new edges in ascending ID order, as with repeated addEdge calls)
+    // throws before modifying the graph if an end vertex does not exist
+    // returns the ID first assigned to e_data[0]
+    EdgeIDType addEdges(MyVector<EdgeRecord> && e_data)
+    {
+        MYGRAPH_SPAN("MyGraph", "addEdges");
+        MyVector<size_t> end_pos;
+        size_t base = reserveEdges(e_data, end_pos);
+        for(size_t i = 0; i < e_data.size(); ++ i)
+        {
+            edge_set.push_back(new Edge(e_data[i].src, e_data[i].tgt, std::move(e_data[i].data)));
+        }
+        return linkNewEdges(base, end_pos);
+    }
+
     // retrieves the information of the edge specified by the eid
     // returns the edge
     Edge* getEdge(const EdgeIDType eid)
@@ -283,55 +588,59 @@ class MyGraph
     // checks whether an exists between src and tgt
     // if yes, return TRUE and record the corresponding edge ID in eid
     // if no, return FALSE
+    // expected time complexity: O(1), through the endpoint-pair index (and the adjacency matrix, if enabled)
     bool probeEdge(const VertexIDType sid, const VertexIDType tid, EdgeIDType& eid)
     {
         // code begins
-        auto* list_s = adj_list[vertexID2SetPos(sid)];
-        for(auto itr = list_s->begin(); itr != list_s->end(); ++itr)
+        size_t pos_s = vertexID2SetPos(sid);
+        if(adj_matrix_enabled)
         {
-            EdgeIDType canidate = *itr;
-            Edge* e = getEdge(canidate);
-            if((e->src == sid && e->tgt == tid) || (e->src == tid && e->tgt == sid))
+            size_t pos_x;
+            if(!vertex_map.get(tid, pos_x))
+            {
+                return false;
+            }
+            ensureAdjMatrix();
+            if(!adj_matrix.test(pos_s * adj_matrix_dim + pos_x))
             {
-                eid = canidate;
-                return true;
+                return false;
             }
         }
-        return false;
+        return edge_index.get(edgeKey(sid, tid), eid);
         // code ends
     }
 
     // returns the degree of the vertex specified by vid
+    // expected time complexity: O(1) (the adjacency list keeps its size)
     size_t degree(const VertexIDType vid)
     {
         // code begins
-        auto* list_v = adj_list[vertexID2SetPos(vid)];
-        size_t deg = 0;
-        for(auto itr = list_v -> begin(); itr != list_v -> end(); ++itr)
-        {
-            ++deg;
-        }
-        return deg;
+        return static_cast<size_t>(adj_list[vertexID2SetPos(vid)] -> size());
         // code ends
     }
 
     // deletes the vertex specified by vid from the graph
-    // also delete all edges associated with it
-    // expected time complexity: O(d^2), where d is the average degree of the graph
+    // also delete all edges associated with it (the log records only the vertex deletion, which implies them)
+    // expected time complexity: O(d), where d is the average degree of the graph
     void deleteVertex(const VertexIDType vid)
     {
         // code begins
+        MYGRAPH_SPAN("MyGraph", "deleteVertex");
         size_t vpos = vertexID2SetPos(vid);
         Vertex* v = vertex_set[vpos];
 
         MyVector<EdgeIDType> to_remove;
         for(auto itr = adj_list[vpos]->begin(); itr != adj_list[vpos]->end(); ++itr)
         {
-            to_remove.push_back(*itr);
+            to_remove.push_back(entryEdge(*itr));
         }
         for(size_t i = 0; i < to_remove.size(); ++i)
         {
-            deleteEdge(to_remove[i]);
+            // a self-loop is listed twice
+            if(edge_map.contains(to_remove[i]))
+            {
+                removeEdge(to_remove[i]);
+            }
         }
         adj_list[vpos]->clear();
         delete adj_list[vpos];
@@ -342,51 +651,135 @@ class MyGraph
         {
             Vertex* back = vertex_set[last];
             vertex_set[vpos] = back;
-            vertex_map.remove(back->id); //sgjdsjgdjsgljdslkfjkdljflskjfldsjlfjsdlfjsdjflsdjflsdjfkljsdlfjsdlfjsld
-            vertex_map.insert(HashedObj<VertexIDType,size_t>(back->id, vpos));
+            vertex_map.set(back->id, vpos);
             adj_list[vpos] = adj_list[last];
         }
         vertex_set.pop_back();
         adj_list.pop_back();
         vertex_map.remove(vid);
+        conn_index_dirty = true;
+        adj_matrix_dirty = true;
         --num_vertices;
+        if(mutation_log != nullptr)
+        {
+            mutation_log->logDeleteVertex(vid);
+            mutation_log->logCommit();
+        }
         // code ends
     }
 
     // deletes the edge specified by eid from the graph
-    // expected time complexity: O(d), where d is the average degree of the graph
+    // expected time complexity: O(min(d_src, d_tgt)); the edge keeps the positions of its nodes in both adjacency lists,
+    // and the shorter list is scanned for a parallel edge to take over its endpoint-pair index entry
     void deleteEdge(const EdgeIDType eid)
     {
         // code begins
-        size_t epos = edgeID2SetPos(eid);
-        Edge* e = edge_set[epos];
-        size_t pos_s = vertexID2SetPos(e->src);
-        size_t pos_x = vertexID2SetPos(e->tgt);
-        adj_list[pos_s]->remove(eid);
-        adj_list[pos_x]->remove(eid);
-        delete e;
-
-        size_t last = edge_set.size()-1;
-        if(epos != last)
+        MYGRAPH_SPAN("MyGraph", "deleteEdge");
+        removeEdge(eid);
+        if(mutation_log != nullptr)
         {
-            Edge* back = edge_set[last];
-            edge_set[epos] = back;
-            edge_map.remove(back->id);
-            edge_map.insert(HashedObj<VertexIDType,size_t>(back->id, epos));
+            mutation_log->logDeleteEdge(eid);
+            mutation_log->logCommit();
         }
-        edge_set.pop_back();
-        edge_map.remove(eid);
-        --num_edges;
         // code ends
     }
 
+    // deletes the vertices specified by vids from the graph, together with all edges associated with them
+    // marks the deleted slots first, then compacts vertex_set, edge_set and adj_list in one pass each,
+    // updating the map entries of the moved elements on the way; the surviving vertices and edges keep their relative order
+    // throws before modifying the graph if any ID does not exist; duplicated IDs are ignored
+    // (the log records only the vertex deletions, which imply the edges)
+    // expected time complexity: O(n + m) for the whole batch
+    void deleteVertices(const MyVector<VertexIDType>& vids)
+    {
+        MYGRAPH_SPAN("MyGraph", "deleteVertices");
+        if(vids.empty())
+        {
+            return;
+        }
+        MyVector<size_t> vpos(vids.size());
+        for(size_t i = 0; i < vids.size(); ++ i)
+        {
+            vpos[i] = vertexID2SetPos(vids[i]);
+        }
+
+        MyVector<EdgeIDType> incident;
+        for(size_t i = 0; i < vpos.size(); ++ i)
+        {
+            for(auto itr = adj_list[vpos[i]]->begin(); itr != adj_list[vpos[i]]->end(); ++itr)
+            {
+                incident.push_back(entryEdge(*itr));
+            }
+        }
+        removeEdges(incident);
+
+        for(size_t i = 0; i < vpos.size(); ++ i)
+        {
+            if(vertex_set[vpos[i]] == nullptr)
+            {
+                continue;
+            }
+            vertex_map.remove(vertex_set[vpos[i]]->id);
+            delete vertex_set[vpos[i]];
+            delete adj_list[vpos[i]];
+            vertex_set[vpos[i]] = nullptr;
+            adj_list[vpos[i]] = nullptr;
+        }
+        size_t kept = 0;
+        for(size_t i = 0; i < vertex_set.size(); ++ i)
+        {
+            if(vertex_set[i] != nullptr)
+            {
+                vertex_set[kept] = vertex_set[i];
+                adj_list[kept] = adj_list[i];
+                vertex_map.set(vertex_set[kept]->id, kept);
+                ++ kept;
+            }
+        }
+        vertex_set.resize(kept);
+        adj_list.resize(kept);
+        num_vertices = kept;
+        conn_index_dirty = true;
+        adj_matrix_dirty = true;
+        if(mutation_log != nullptr)
+        {
+            mutation_log->logDeleteVertices(vids);
+            mutation_log->logCommit();
+        }
+        return;
+    }
+
+    // deletes the edges specified by eids from the graph
+    // marks the deleted slots first, then compacts edge_set in one pass, updating edge_map on the way;
+    // the surviving edges keep their relative order
+    // throws before modifying the graph if any ID does not exist; duplicated IDs are ignored
+    // expected time complexity: O(m) for the whole batch, plus the parallel-edge scans of deleteEdge
+    void deleteEdges(const MyVector<EdgeIDType>& eids)
+    {
+        MYGRAPH_SPAN("MyGraph", "deleteEdges");
+        removeEdges(eids);
+        if(mutation_log != nullptr && !eids.empty())
+        {
+            mutation_log->logDeleteEdges(eids);
+            mutation_log->logCommit();
+        }
+        return;
+    }
+
     // performs breath-first-search on the graph, starting from v_src
     // record the path in path
-    // outgoing edge visit order should be determined based on their ID (smaller ID visited earlier)
+    // with BFS_EDGE_ID_ORDER, outgoing edge visit order is determined based on their ID (smaller ID visited earlier)
+    // with BFS_DIRECTION_OPTIMIZING, the path is still ordered by level, but the order inside a level is unspecified
     // the source vertex should also be included in the traversal path
-    void breadthFirstSearch(const VertexIDType v_src, MyVector<VertexIDType>& path)
+    void breadthFirstSearch(const VertexIDType v_src, MyVector<VertexIDType>& path, const BFSMode mode = BFS_DIRECTION_OPTIMIZING)
     {
         // code begins
+        MYGRAPH_SPAN("MyGraph", "breadthFirstSearch");
+        if(mode == BFS_DIRECTION_OPTIMIZING)
+        {
+            directionOptimizingBFS(vertexID2SetPos(v_src), path);
+            return;
+        }
         path.resize(0);
         MyHashTable<VertexIDType, bool> visited;
         MyQueue<VertexIDType> queue;
@@ -401,8 +794,13 @@ class MyGraph
             MyVector<EdgeIDType> edges;
             for(auto itr = adj_list[pos_u] ->begin(); itr != adj_list[pos_u]->end(); ++itr)
             {
-                edges.push_back(*itr);
+                if(entryLeads(pos_u, *itr, STEP_OUT))
+                {
+                    edges.push_back(entryEdge(*itr));
+                }
             }
+            MYGRAPH_COUNT(cnt_traversal_vertices, 1);
+            MYGRAPH_COUNT(cnt_traversal_edges, edges.size());
             for(size_t i = 0; i < edges.size(); ++i)
             {
                 for(size_t j = i+1; j < edges.size(); ++j)
@@ -428,6 +826,115 @@ class MyGraph
         // code ends
     }
 
+    // performs a level-synchronous parallel breadth-first-search on the graph, starting from v_src
+    // every level is expanded in chunks on the threads of pool; vertices are claimed with an atomic test-and-set
+    // record the path in path, ordered by level (the order inside a level is unspecified)
+    // level[i] is the hop distance of path[i] from v_src and parent[i] is the ID of the vertex that discovered path[i]
+    // (the source is its own parent)
+    void parallelBreadthFirstSearch(const VertexIDType v_src, MyVector<VertexIDType>& path, MyVector<long long>& level,
+                                    MyVector<VertexIDType>& parent, MyThreadPool& pool)
+    {
+        MYGRAPH_SPAN("MyGraph", "parallelBreadthFirstSearch");
+        const size_t BFS_CHUNK = 256;
+        size_t n = vertex_set.size();
+        size_t pos_src = vertexID2SetPos(v_src);
+        size_t num_words = (n + 63) / 64;
+        std::unique_ptr<std::atomic<unsigned long long>[]> visited(new std::atomic<unsigned long long>[num_words]);
+        pool.parallelFor(0, num_words, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                visited[i].store(0, std::memory_order_relaxed);
+            }
+        });
+
+        MyVector<size_t> order;             // the visited positions; level l occupies [level_start[l], level_start[l + 1])
+        MyVector<size_t> level_start;
+        MyVector<size_t> parent_pos(n);     // only meaningful for visited positions
+        MyVector<FrontierBuffer> local(pool.numThreads());
+        order.reserve(n);
+        order.push_back(pos_src);
+        parent_pos[pos_src] = pos_src;
+        visited[pos_src / 64].store(1ULL << (pos_src % 64), std::memory_order_relaxed);
+        level_start.push_back(0);
+        level_start.push_back(1);
+
+        while(level_start[level_start.size() - 2] < level_start.back())
+        {
+            for(size_t t = 0; t < local.size(); ++ t)
+            {
+                local[t].items.resize(0);
+            }
+            pool.parallelFor(level_start[level_start.size() - 2], level_start.back(), BFS_CHUNK, [&](size_t tid, size_t lo, size_t hi)
+            {
+                MYGRAPH_SPAN("MyGraph", "parallelBreadthFirstSearch.chunk");
+                MyVector<size_t>& buf = local[tid].items;
+                size_t scanned = 0;
+                LookupTally tally;
+                for(size_t i = lo; i < hi; ++ i)
+                {
+                    size_t u = order[i];
+                    scanned += adj_list[u]->size();
+                    for(auto itr = adj_list[u]->begin(); itr != adj_list[u]->end(); ++itr)
+                    {
+                        size_t w;
+                        if(!stepEntry(u, *itr, STEP_OUT, w, &tally))
+                        {
+                            continue;
+                        }
+                        unsigned long long mask = 1ULL << (w % 64);
+                        // test before test-and-set, so already visited vertices cost no atomic write
+                        if((visited[w / 64].load(std::memory_order_relaxed) & mask) == 0 &&
+                           (visited[w / 64].fetch_or(mask, std::memory_order_relaxed) & mask) == 0)
+                        {
+                            parent_pos[w] = u;
+                            buf.push_back(w);
+                        }
+                    }
+                }
+                MYGRAPH_COUNT(cnt_traversal_edges, scanned);
+                addLookups(tally);
+            });
+
+            // append the per-thread buffers to order at precomputed offsets
+            size_t level_end = level_start.back();
+            MyVector<size_t> offset(local.size());
+            for(size_t t = 0; t < local.size(); ++ t)
+            {
+                offset[t] = level_end;
+                level_end += local[t].items.size();
+            }
+            order.resize(level_end);
+            pool.run([&](size_t tid)
+            {
+                for(size_t i = 0; i < local[tid].items.size(); ++ i)
+                {
+                    order[offset[tid] + i] = local[tid].items[i];
+                }
+            });
+            level_start.push_back(level_end);
+        }
+
+        size_t num_visited = order.size();
+        MYGRAPH_COUNT(cnt_traversal_vertices, num_visited);
+        path.resize(num_visited);
+        level.resize(num_visited);
+        parent.resize(num_visited);
+        for(size_t l = 0; l + 1 < level_start.size(); ++ l)
+        {
+            pool.parallelFor(level_start[l], level_start[l + 1], 4096, [&](size_t, size_t lo, size_t hi)
+            {
+                for(size_t i = lo; i < hi; ++ i)
+                {
+                    path[i] = vertex_set[order[i]]->id;
+                    level[i] = static_cast<long long>(l);
+                    parent[i] = vertex_set[parent_pos[order[i]]]->id;
+                }
+            });
+        }
+        return;
+    }
+
     // performs depth-first-search on the graph, starting from v_src
     // record the path in path
     // outgoing edge visit order should be determined based on their ID (smaller ID visited earlier)
@@ -435,6 +942,7 @@ class MyGraph
     void depthFirstSearch(const VertexIDType v_src, MyVector<VertexIDType>& path)
     {
         // code begins
+        MYGRAPH_SPAN("MyGraph", "depthFirstSearch");
         path.resize(0);
         MyHashTable<VertexIDType, bool> visited;
         MyStack<VertexIDType> stack;
@@ -454,8 +962,13 @@ class MyGraph
             MyVector<EdgeIDType> edges;
             for(auto itr = adj_list[pos_u]->begin(); itr != adj_list[pos_u]->end(); ++itr)
             {
-                edges.push_back(*itr);
+                if(entryLeads(pos_u, *itr, STEP_OUT))
+                {
+                    edges.push_back(entryEdge(*itr));
+                }
             }
+            MYGRAPH_COUNT(cnt_traversal_vertices, 1);
+            MYGRAPH_COUNT(cnt_traversal_edges, edges.size());
             for(size_t i = 0; i < edges.size(); ++i)
             {
                 for(size_t j = i+1; j < edges.size(); ++j)
@@ -483,162 +996,2267 @@ class MyGraph
     // determines whether the two nodes vid1 and vid2 are connected
     // if yes, return TRUE
     // if no, return FASLE
+    // answered from the connectivity index; expected time complexity: O(alpha(n)),
+    // plus a one-time O(n + m) rebuild of the index after a deletion
+    // without the index (see setConnectivityIndex), runs a bidirectional BFS instead
     bool isConnected(const VertexIDType vid1, const VertexIDType vid2)
     {
         // code begins
+        MYGRAPH_SPAN("MyGraph", "isConnected");
         if(vid1 == vid2)
         {
             return true;
         }
-        MyHashTable<VertexIDType, bool> visited;
-        MyQueue<VertexIDType> queue;
-        visited.insert(HashedObj<VertexIDType,bool>(vid1, true));
-        queue.enqueue(vid1);
-        while(!queue.empty())
+        size_t pos_1 = vertexID2SetPos(vid1);
+        size_t pos_2 = vertexID2SetPos(vid2);
+        if(conn_index_enabled)
         {
-            VertexIDType u = queue.front(); 
-            queue.dequeue();
-            size_t pos_u = vertexID2SetPos(u);
-            for(auto itr = adj_list[pos_u]->begin(); itr != adj_list[pos_u]->end(); ++itr)
-            {
-                Edge* e = getEdge(*itr);
-                VertexIDType v = (e->src == u ? e->tgt : e->src);
-                bool seen;
-                if(!visited.get(v,seen))
-                {
-                    if(v == vid2)
-                    {
-                        return true;
-                    }
-                    visited.insert(HashedObj<VertexIDType,bool>(v, true));
-                    queue.enqueue(v);
-                }
-            }
+            ensureConnIndex();
+        }
+        if(!conn_index_dirty)
+        {
+            return conn_index.connected(pos_1, pos_2);
         }
-        return false;
+        return bidirectionalSearch(pos_1, pos_2, false) >= 0;
         // code ends
     }
 
-    // returns the number of vertices in the graph
-    size_t numVertices(void) const
+    // returns the number of edges on a shortest path between vid1 and vid2
+    // returns -1 if they are not connected
+    // runs a bidirectional BFS that always expands the smaller frontier
+    long long hopDistance(const VertexIDType vid1, const VertexIDType vid2)
     {
-        return num_vertices;
+        MYGRAPH_SPAN("MyGraph", "hopDistance");
+        size_t pos_1 = vertexID2SetPos(vid1);
+        size_t pos_2 = vertexID2SetPos(vid2);
+        if(!conn_index_dirty && !conn_index.connected(pos_1, pos_2))
+        {
+            return -1;
+        }
+        return bidirectionalSearch(pos_1, pos_2, true);
     }
 
-    // returns the number of edges in the graph
-    size_t numEdges(void) const
+    // turns the connectivity index used by isConnected on or off
+    // when off, the index is released and isConnected falls back to bidirectional BFS
+    // (componentId and numComponents still build the index on demand)
+    void setConnectivityIndex(const bool enabled)
     {
-        return num_edges;
+        conn_index_enabled = enabled;
+        if(!enabled)
+        {
+            conn_index.reset(0);
+            conn_index_dirty = true;
+        }
+        return;
     }
 
-    // checks whether the graph is empty (no vertex)
-    bool empty(void) const
+    // returns an identifier of the connected component containing vid
+    // two vertices are connected iff they have the same component ID
+    // the IDs are only stable until the next addition or deletion
+    size_t componentId(const VertexIDType vid)
     {
-        return (num_vertices == 0);
+        size_t pos = vertexID2SetPos(vid);
+        ensureConnIndex();
+        return conn_index.find(pos);
     }
 
-    // prints the content in vertex_set
-    void printInfoVertexSet(void) 
+    // returns the number of connected components in the graph
+    size_t numComponents(void)
     {
-        for(size_t i = 0; i < num_vertices; ++ i)
-        {
-            std::cout << "Array Position: " << i << "\t";
-            std::cout << "Vertex ID: " << vertex_set[i]->id << "\t";
-            std::cout << "Vertex data: " << vertex_set[i]->data << std::endl;
-        }
-        return;
+        ensureConnIndex();
+        return conn_index.numSets();
     }
 
-    // prints the content in edge_set
-    void printInfoEdgeSet(void) 
+    // labels every vertex with its connected component, in parallel on the threads of pool
+    // labels[vid] is the smallest vertex ID in the component of vid; labels gets one entry per vertex ID
+    // handed out so far (plus entry 0), and the entries of unused IDs are 0; returns the number of components
+    // in directed graphs the components are the weakly connected ones, as for componentId
+    // runs Afforest: every vertex is first hooked to its first CC_SAMPLE_ROUNDS neighbours, then one pass over
+    // edge_set hooks the remaining edges, skipping those inside the largest component found so far
+    // trees are hooked with a compare-and-swap of the larger root to the smaller one, so labels only decrease
+    size_t connectedComponents(MyVector<VertexIDType>& labels, MyThreadPool& pool)
     {
-        for(size_t i = 0; i < num_edges; ++ i)
+        MYGRAPH_SPAN("MyGraph", "connectedComponents");
+        const size_t CC_CHUNK = 1024;
+        const size_t CC_SAMPLE_ROUNDS = 2;
+        const size_t CC_SAMPLE_SIZE = 1024;
+        size_t n = vertex_set.size();
+        size_t m = edge_set.size();
+
+        // comp[p] is the parent of position p in its tree; comp[p] <= p always holds, so the trees have no cycles
+        std::unique_ptr<std::atomic<size_t>[]> comp(new std::atomic<size_t>[n]);
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
         {
-            std::cout << "Array Position: " << i << "\t";
-            std::cout << "Edge ID: " << edge_set[i]->id << "\t";
-            std::cout << "Edge ends: " << edge_set[i]->src << "\t" << edge_set[i]->tgt << "\t";
-            std::cout << "Edge data: " << edge_set[i]->data << std::endl;
-        }
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                comp[i].store(i, std::memory_order_relaxed);
+            }
+        });
+
+        // hooks the trees of pos_u and pos_w together
+        auto link = [&](const size_t pos_u, const size_t pos_w)
+        {
+            size_t p1 = comp[pos_u].load(std::memory_order_relaxed);
+            size_t p2 = comp[pos_w].load(std::memory_order_relaxed);
+            while(p1 != p2)
+            {
+                size_t high = std::max(p1, p2);
+                size_t low = std::min(p1, p2);
+                size_t p_high = comp[high].load(std::memory_order_relaxed);
+                if(p_high == low)
+                {
+                    break;
+                }
+                if(p_high == high && comp[high].compare_exchange_strong(p_high, low, std::memory_order_relaxed))
+                {
+                    break;
+                }
+                // high was hooked by another thread meanwhile; retry from the roots one level up
+                p1 = comp[comp[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+                p2 = comp[low].load(std::memory_order_relaxed);
+            }
+        };
+        // points every position directly to the root of its tree
+        auto compress = [&]()
+        {
+            pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+            {
+                for(size_t i = lo; i < hi; ++ i)
+                {
+                    size_t p = comp[i].load(std::memory_order_relaxed);
+                    size_t pp = comp[p].load(std::memory_order_relaxed);
+                    while(p != pp)
+                    {
+                        p = pp;
+                        pp = comp[p].load(std::memory_order_relaxed);
+                    }
+                    comp[i].store(p, std::memory_order_relaxed);
+                }
+            });
+        };
+
+        // hooks every vertex to its r-th neighbour, one round per r
+        for(size_t r = 0; r < CC_SAMPLE_ROUNDS; ++ r)
+        {
+            pool.parallelFor(0, n, CC_CHUNK, [&](size_t, size_t lo, size_t hi)
+            {
+                LookupTally tally;
+                for(size_t u = lo; u < hi; ++ u)
+                {
+                    auto itr = adj_list[u]->begin();
+                    size_t k = 0;
+                    for(; k < r && itr != adj_list[u]->end(); ++ k)
+                    {
+                        ++ itr;
+                    }
+                    size_t w;
+                    if(itr != adj_list[u]->end() && stepEntry(u, *itr, STEP_ANY, w, &tally))
+                    {
+                        link(u, w);
+                    }
+                }
+                addLookups(tally);
+            });
+            compress();
+        }
+
+        // the most frequent root among evenly spread sample positions is (very likely) the largest component
+        size_t largest = n;
+        if(n > 0)
+        {
+            size_t num_samples = std::min(n, CC_SAMPLE_SIZE);
+            MyVector<size_t> sample(num_samples);
+            for(size_t i = 0; i < num_samples; ++ i)
+            {
+                sample[i] = comp[i * n / num_samples].load(std::memory_order_relaxed);
+            }
+            std::sort(sample.begin(), sample.begin() + num_samples);
+            size_t best_count = 0;
+            for(size_t i = 0, j = 0; i < num_samples; i = j)
+            {
+                j = i + 1;
+                while(j < num_samples && sample[j] == sample[i])
+                {
+                    ++ j;
+                }
+                if(j - i > best_count)
+                {
+                    best_count = j - i;
+                    largest = sample[i];
+                }
+            }
+        }
+
+        // hooks the ends of every edge not already inside the largest component
+        // (after compress, its members point to its root directly, and keep doing so while it is hooked further)
+        pool.parallelFor(0, m, CC_CHUNK, [&](size_t, size_t lo, size_t hi)
+        {
+            LookupTally tally;
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                size_t pos_s = vertexID2SetPos(edge_set[i]->src, &tally);
+                size_t pos_t = vertexID2SetPos(edge_set[i]->tgt, &tally);
+                if(comp[pos_s].load(std::memory_order_relaxed) != largest || comp[pos_t].load(std::memory_order_relaxed) != largest)
+                {
+                    link(pos_s, pos_t);
+                }
+            }
+            addLookups(tally);
+        });
+        compress();
+
+        // labels each component with its smallest vertex ID, so the labels do not depend on the thread schedule
+        std::unique_ptr<std::atomic<VertexIDType>[]> min_id(new std::atomic<VertexIDType>[n]);
+        std::atomic<size_t> num_roots(0);
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            size_t roots = 0;
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                min_id[i].store(vertex_set[i]->id, std::memory_order_relaxed);
+                roots += (comp[i].load(std::memory_order_relaxed) == i);
+            }
+            num_roots.fetch_add(roots, std::memory_order_relaxed);
+        });
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                size_t root = comp[i].load(std::memory_order_relaxed);
+                VertexIDType vid = vertex_set[i]->id;
+                VertexIDType cur = min_id[root].load(std::memory_order_relaxed);
+                while(vid < cur && !min_id[root].compare_exchange_weak(cur, vid, std::memory_order_relaxed))
+                {
+                }
+            }
+        });
+        fillByID(labels, static_cast<VertexIDType>(0), pool);
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                labels[vertex_set[i]->id] = min_id[comp[i].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+            }
+        });
+        MYGRAPH_COUNT(cnt_traversal_vertices, n);
+        MYGRAPH_COUNT(cnt_traversal_edges, m);
+        return num_roots.load(std::memory_order_relaxed);
+    }
+
+    // returns the number of triangles (three vertices joined pairwise by edges), counted in parallel on the threads of pool
+    // edge directions, self-loops and parallel edges are ignored
+    // every triangle is found once, as the common entries of two degree-ordered sorted lists (see RankedAdjacency);
+    // throws std::domain_error if the graph has more than 2^32 - 1 vertices
+    unsigned long long countTriangles(MyThreadPool& pool)
+    {
+        MYGRAPH_SPAN("MyGraph", "countTriangles");
+        RankedAdjacency ranked;
+        buildRankedAdjacency(ranked, pool);
+        return rankedTriangles(ranked, nullptr, pool);
+    }
+
+    // as above, and also counts the triangles at every vertex: counts[vid] is the number of triangles containing vid
+    // counts gets one entry per vertex ID handed out so far (plus entry 0), and the entries of unused IDs are 0
+    unsigned long long countTriangles(MyVector<unsigned long long>& counts, MyThreadPool& pool)
+    {
+        MYGRAPH_SPAN("MyGraph", "countTriangles");
+        RankedAdjacency ranked;
+        buildRankedAdjacency(ranked, pool);
+        size_t n = ranked.pos.size();
+        std::unique_ptr<std::atomic<unsigned long long>[]> per_rank(new std::atomic<unsigned long long>[n]);
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t r = lo; r < hi; ++ r)
+            {
+                per_rank[r].store(0, std::memory_order_relaxed);
+            }
+        });
+        unsigned long long total = rankedTriangles(ranked, per_rank.get(), pool);
+        fillByID(counts, 0ULL, pool);
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t r = lo; r < hi; ++ r)
+            {
+                counts[vertex_set[ranked.pos[r]]->id] = per_rank[r].load(std::memory_order_relaxed);
+            }
+        });
+        return total;
+    }
+
+    // computes the local clustering coefficient of every vertex: the fraction of the pairs of its neighbours that are
+    // adjacent, 2 t(v) / (d(v) (d(v) - 1)) for t(v) triangles at v and d(v) distinct neighbours other than v (0 if d(v) < 2)
+    // coeffs is indexed by vertex ID like the counts of countTriangles; returns the average coefficient over all vertices
+    double clusteringCoefficients(MyVector<double>& coeffs, MyThreadPool& pool)
+    {
+        MYGRAPH_SPAN("MyGraph", "clusteringCoefficients");
+        RankedAdjacency ranked;
+        buildRankedAdjacency(ranked, pool);
+        size_t n = ranked.pos.size();
+        std::unique_ptr<std::atomic<unsigned long long>[]> per_rank(new std::atomic<unsigned long long>[n]);
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t r = lo; r < hi; ++ r)
+            {
+                per_rank[r].store(0, std::memory_order_relaxed);
+            }
+        });
+        rankedTriangles(ranked, per_rank.get(), pool);
+        fillByID(coeffs, 0.0, pool);
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t r = lo; r < hi; ++ r)
+            {
+                double d = ranked.degree[r];
+                coeffs[vertex_set[ranked.pos[r]]->id] = (d < 2 ? 0.0 : 2.0 * per_rank[r].load(std::memory_order_relaxed) / (d * (d - 1)));
+            }
+        });
+        // summed in ID order, so the average does not depend on the thread schedule
+        double sum = 0;
+        for(size_t i = 0; i < coeffs.size(); ++ i)
+        {
+            sum += coeffs[i];
+        }
+        return (n == 0 ? 0.0 : sum / n);
+    }
+
+    // fills edges_out with the IDs of the edges of a minimum spanning forest (a minimum spanning tree of every component)
+    // in ascending order, with the edge properties as the weights; runs on the threads of pool
+    // equal weights are ordered by edge ID, so the forest is unique and both algorithms return the same edges
+    // edge directions are ignored and self-loops are never in the forest; EdgeDataType needs operator<
+    void minimumSpanningForest(MyVector<EdgeIDType>& edges_out, MyThreadPool& pool, const MSFAlgorithm algorithm = MSF_BORUVKA)
+    {
+        MYGRAPH_SPAN("MyGraph", "minimumSpanningForest");
+        size_t m = edge_set.size();
+        MyVector<WeightedEdge> candidates(m);
+        pool.parallelFor(0, m, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            LookupTally tally;
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                const Edge* e = edge_set[i];
+                candidates[i].weight = e->data;
+                candidates[i].id = e->id;
+                candidates[i].pos_s = vertexID2SetPos(e->src, &tally);
+                candidates[i].pos_t = vertexID2SetPos(e->tgt, &tally);
+            }
+            addLookups(tally);
+        });
+        MyVector<EdgeIDType> forest;
+        forest.reserve(vertex_set.size());
+        if(algorithm == MSF_BORUVKA)
+        {
+            boruvkaForest(candidates, forest, pool);
+        }
+        else
+        {
+            MyDisjointSet sets(vertex_set.size());
+            MyVector<WeightedEdge> buffer(m);
+            filterKruskal(candidates, buffer, 0, m, sets, forest, pool);
+        }
+        if(forest.size() > 0)
+        {
+            std::sort(forest.begin(), forest.begin() + forest.size());
+        }
+        MYGRAPH_COUNT(cnt_traversal_edges, m);
+        edges_out = std::move(forest);
+        return;
+    }
+
+    // turns the adjacency-matrix filter used by probeEdge on or off
+    // the matrix holds one bit per pair of vertex_set positions, so it is meant for small, dense graphs;
+    // it is rebuilt lazily after a vertex deletion or once the graph outgrows it
+    void setAdjacencyMatrix(const bool enabled)
+    {
+        adj_matrix_enabled = enabled;
+        adj_matrix_dirty = true;
+        adj_matrix_dim = 0;
+        adj_matrix.resize(0);
+        return;
+    }
+
+    // turns the reuse of deleted vertex and edge IDs on or off
+    // while on, addVertex/addEdge hand out the most recently deleted ID before an unused one,
+    // which keeps the ID maps from growing without bound under churn
+    // (IDs then no longer follow the order of insertion; addVertices/addEdges always use unused IDs)
+    void setIDRecycling(const bool enabled)
+    {
+        vertex_map.setRecycling(enabled);
+        edge_map.setRecycling(enabled);
+        return;
+    }
+
+    // attaches a log that is told about every later addition and deletion (see MyGraphLog_c336t319.h); nullptr detaches it
+    // load replaces the whole graph without telling the log; use MyGraphLog::checkpoint to persist a new state instead
+    void setLog(MyGraphLogSink<VertexDataType, EdgeDataType>* log)
+    {
+        mutation_log = log;
+        return;
+    }
+
+    // writes the graph to the file at path in the binary snapshot format (see MySnapshot_c336t319.h)
+    // vertex and edge data must be trivially copyable or std::string
+    // keeps the IDs, the tags and the order of vertex_set, edge_set and every adjacency list;
+    // the deleted IDs kept for recycling (see setIDRecycling) are not saved
+    // returns false if the file cannot be written
+    bool save(const std::string& path)
+    {
+        MYGRAPH_SPAN("MyGraph", "save");
+        typedef MySnapshotCodec<VertexDataType> VertexCodec;
+        typedef MySnapshotCodec<EdgeDataType> EdgeCodec;
+        std::ofstream out(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!out.is_open())
+        {
+            return false;
+        }
+        size_t n = vertex_set.size();
+        size_t m = edge_set.size();
+        MySnapshotHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "MYGRAPH", 8);
+        header.version = MYSNAPSHOT_VERSION;
+        header.endian_check = MYSNAPSHOT_ENDIAN_CHECK;
+        header.header_bytes = sizeof(MySnapshotHeader);
+        header.id_bytes = sizeof(int64_t);
+        header.vertex_data_kind = VertexCodec::KIND;
+        header.vertex_data_bytes = VertexCodec::BYTES;
+        header.edge_data_kind = EdgeCodec::KIND;
+        header.edge_data_bytes = EdgeCodec::BYTES;
+        header.directed = (GraphPolicy::directed ? 1 : 0);
+        header.num_vertices = n;
+        header.num_edges = m;
+        header.current_vertex_id = current_vertex_ID;
+        header.current_edge_id = current_edge_ID;
+        // a placeholder; the header is written again once the section table is complete
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        MySnapshotWriter writer(out, header);
+
+        // the vertices
+        MyVector<int64_t> ids(n);
+        MyVector<int32_t> tags(n);
+        for(size_t i = 0; i < n; ++ i)
+        {
+            ids[i] = vertex_set[i]->id;
+            tags[i] = vertex_set[i]->tag;
+        }
+        writer.section(SNAP_VERTEX_IDS, ids);
+        writer.section(SNAP_VERTEX_TAGS, tags);
+        auto vertex_data = [this](const size_t i) -> const VertexDataType& { return vertex_set[i]->data; };
+        uint64_t blob_bytes;
+        writer.begin(SNAP_VERTEX_DATA);
+        VertexCodec::write(out, n, vertex_data, blob_bytes);
+        writer.end(SNAP_VERTEX_DATA, VertexCodec::dataBytes(n));
+        writer.begin(SNAP_VERTEX_BLOB);
+        VertexCodec::writeBlob(out, n, vertex_data);
+        writer.end(SNAP_VERTEX_BLOB, blob_bytes);
+
+        // the edges
+        MyVector<int64_t> srcs(m);
+        MyVector<int64_t> tgts(m);
+        ids.resize(m);
+        tags.resize(m);
+        for(size_t j = 0; j < m; ++ j)
+        {
+            ids[j] = edge_set[j]->id;
+            srcs[j] = edge_set[j]->src;
+            tgts[j] = edge_set[j]->tgt;
+            tags[j] = edge_set[j]->tag;
+        }
+        writer.section(SNAP_EDGE_IDS, ids);
+        writer.section(SNAP_EDGE_SRC, srcs);
+        writer.section(SNAP_EDGE_TGT, tgts);
+        writer.section(SNAP_EDGE_TAGS, tags);
+        auto edge_data = [this](const size_t j) -> const EdgeDataType& { return edge_set[j]->data; };
+        writer.begin(SNAP_EDGE_DATA);
+        EdgeCodec::write(out, m, edge_data, blob_bytes);
+        writer.end(SNAP_EDGE_DATA, EdgeCodec::dataBytes(m));
+        writer.begin(SNAP_EDGE_BLOB);
+        EdgeCodec::writeBlob(out, m, edge_data);
+        writer.end(SNAP_EDGE_BLOB, blob_bytes);
+
+        // the adjacency lists in CSR form (positions instead of IDs); in directed graphs the target ends are flagged
+        MyVector<uint64_t> offsets(n + 1);
+        MyVector<uint64_t> adj_edges(2 * m);
+        MyVector<uint64_t> adj_nbrs(2 * m);
+        size_t k = 0;
+        offsets[0] = 0;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            VertexIDType vid = vertex_set[i]->id;
+            for(auto itr = adj_list[i]->begin(); itr != adj_list[i]->end(); ++itr)
+            {
+                size_t epos = edgeID2SetPos(entryEdge(*itr));
+                Edge* e = edge_set[epos];
+                adj_edges[k] = epos | (GraphPolicy::directed && itr != e->src_itr ? SNAP_ADJ_IN_ENTRY : 0);
+                adj_nbrs[k] = vertexID2SetPos(e->src == vid ? e->tgt : e->src);
+                ++ k;
+            }
+            offsets[i + 1] = k;
+        }
+        writer.section(SNAP_ADJ_OFFSETS, offsets);
+        writer.section(SNAP_ADJ_EDGES, adj_edges);
+        writer.section(SNAP_ADJ_NEIGHBORS, adj_nbrs);
+
+        header.file_bytes = writer.position();
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        return !out.fail();
+    }
+
+    // replaces the contents of the graph with the snapshot at path (written by save)
+    // the file is memory-mapped (or read in one go where mmap is unavailable) and its arrays are used in place,
+    // so nothing is parsed; the vertex, edge and list objects are still allocated one by one
+    // returns false if the file cannot be opened
+    // throws std::domain_error if the file is not a valid snapshot of this graph type (including its direction policy);
+    // the graph is left unchanged if the header, the section table or the adjacency offsets are wrong, and empty if the
+    // damage is found later
+    bool load(const std::string& path)
+    {
+        MYGRAPH_SPAN("MyGraph", "load");
+        typedef MySnapshotCodec<VertexDataType> VertexCodec;
+        typedef MySnapshotCodec<EdgeDataType> EdgeCodec;
+        MyMappedFile file;
+        if(!file.open(path))
+        {
+            return false;
+        }
+        MySnapshotReader reader(file.data(), file.size());
+        reader.checkDataTypes<VertexDataType, EdgeDataType>();
+        reader.checkDirected(GraphPolicy::directed);
+        reader.checkAdjacency();
+        const MySnapshotHeader& header = reader.info();
+        size_t n = header.num_vertices;
+        size_t m = header.num_edges;
+
+        releaseAll();
+        try
+        {
+            // the vertices
+            const int64_t* v_ids = reader.array<int64_t>(SNAP_VERTEX_IDS);
+            const int32_t* v_tags = reader.array<int32_t>(SNAP_VERTEX_TAGS);
+            const char* v_data = reader.array<char>(SNAP_VERTEX_DATA);
+            const char* v_blob = reader.array<char>(SNAP_VERTEX_BLOB);
+            vertex_set.reserve(n);
+            adj_list.reserve(n);
+            for(size_t i = 0; i < n; ++ i)
+            {
+                if(v_ids[i] <= 0 || static_cast<uint64_t>(v_ids[i]) > header.current_vertex_id)
+                {
+                    throw std::domain_error("MyGraph::load: corrupted snapshot (vertex ID)");
+                }
+                Vertex* v = new Vertex();
+                vertex_set.push_back(v);
+                v->id = v_ids[i];
+                v->tag = v_tags[i];
+                VertexCodec::read(v_data, v_blob, reader.bytes(SNAP_VERTEX_BLOB), i, v->data);
+                if(!vertex_map.insert(v->id, i))
+                {
+                    throw std::domain_error("MyGraph::load: corrupted snapshot (duplicate vertex ID)");
+                }
+                adj_list.push_back(new AdjListType());
+            }
+
+            // the edges
+            const int64_t* e_ids = reader.array<int64_t>(SNAP_EDGE_IDS);
+            const int64_t* e_srcs = reader.array<int64_t>(SNAP_EDGE_SRC);
+            const int64_t* e_tgts = reader.array<int64_t>(SNAP_EDGE_TGT);
+            const int32_t* e_tags = reader.array<int32_t>(SNAP_EDGE_TAGS);
+            const char* e_data = reader.array<char>(SNAP_EDGE_DATA);
+            const char* e_blob = reader.array<char>(SNAP_EDGE_BLOB);
+            edge_set.reserve(m);
+            edge_index.clear(m);
+            for(size_t j = 0; j < m; ++ j)
+            {
+                if(e_ids[j] <= 0 || static_cast<uint64_t>(e_ids[j]) > header.current_edge_id
+                   || !vertex_map.contains(e_srcs[j]) || !vertex_map.contains(e_tgts[j]))
+                {
+                    throw std::domain_error("MyGraph::load: corrupted snapshot (edge ID or end vertex)");
+                }
+                Edge* e = new Edge();
+                edge_set.push_back(e);
+                e->id = e_ids[j];
+                e->src = e_srcs[j];
+                e->tgt = e_tgts[j];
+                e->tag = e_tags[j];
+                EdgeCodec::read(e_data, e_blob, reader.bytes(SNAP_EDGE_BLOB), j, e->data);
+                if(!edge_map.insert(e->id, j))
+                {
+                    throw std::domain_error("MyGraph::load: corrupted snapshot (duplicate edge ID)");
+                }
+                // of parallel edges, addEdge indexes the first one; edge_set order need not be ID order
+                EdgeIDType indexed;
+                if(!edge_index.get(edgeKey(e->src, e->tgt), indexed))
+                {
+                    edge_index.insert(HashedObj<EdgeKeyType,EdgeIDType>(edgeKey(e->src, e->tgt), e->id));
+                }
+                else if(e->id < indexed)
+                {
+                    edge_index.remove(edgeKey(e->src, e->tgt));
+                    edge_index.insert(HashedObj<EdgeKeyType,EdgeIDType>(edgeKey(e->src, e->tgt), e->id));
+                }
+            }
+
+            // the adjacency lists; every edge must appear once at its source and once at its target
+            // (a self-loop's first entry is its source end, as addEdge inserts it first; directed snapshots flag the target ends)
+            const uint64_t* off = reader.array<uint64_t>(SNAP_ADJ_OFFSETS);
+            const uint64_t* adj_edges = reader.array<uint64_t>(SNAP_ADJ_EDGES);
+            MyBitmap src_done(m);
+            MyBitmap tgt_done(m);
+            for(size_t i = 0; i < n; ++ i)
+            {
+                VertexIDType vid = vertex_set[i]->id;
+                AdjListType* list = adj_list[i];
+                for(uint64_t k = off[i]; k < off[i + 1]; ++ k)
+                {
+                    size_t epos = MySnapshotReader::entryEdge(adj_edges[k]);
+                    bool in_entry = (adj_edges[k] & SNAP_ADJ_IN_ENTRY) != 0;
+                    Edge* e = edge_set[epos];
+                    if(!in_entry && e->src == vid && !src_done.test(epos))
+                    {
+                        e->src_itr = list->insert(list->end(), makeEntry(e, true));
+                        src_done.set(epos);
+                    }
+                    else if((in_entry || !GraphPolicy::directed) && e->tgt == vid && !tgt_done.test(epos))
+                    {
+                        e->tgt_itr = list->insert(list->end(), makeEntry(e, false));
+                        tgt_done.set(epos);
+                    }
+                    else
+                    {
+                        throw std::domain_error("MyGraph::load: corrupted snapshot (adjacency entry)");
+                    }
+                }
+            }
+        }
+        catch(...)
+        {
+            releaseAll();
+            throw;
+        }
+        // 2m entries, each marking a different end, so every edge is linked at both ends
+        current_vertex_ID = header.current_vertex_id;
+        current_edge_ID = header.current_edge_id;
+        num_vertices = n;
+        num_edges = m;
+        conn_index_dirty = true;
+        return true;
+    }
+
+    // renumbers the vertex_set positions for memory locality; IDs, data, tags and Vertex/Edge pointers stay valid
+    // rebuilds every adjacency list (in its old edge order) with nodes allocated in the new vertex order,
+    // and groups edge_set by the smaller end position, so a traversal stays close to the memory it just touched
+    // save keeps the new order, so snapshots and MyGraphView benefit as well
+    // expected time complexity: O(n + m), plus sorting the neighbours of each vertex by degree for REORDER_RCM
+    void reorder(const ReorderStrategy strategy)
+    {
+        MYGRAPH_SPAN("MyGraph", "reorder");
+        size_t n = vertex_set.size();
+        size_t m = edge_set.size();
+        MyVector<size_t> order;     // order[new position] = old position
+        if(strategy == REORDER_DEGREE_DESCENDING)
+        {
+            degreeOrder(order);
+        }
+        else
+        {
+            breadthFirstOrder(order, strategy == REORDER_RCM);
+        }
+
+        // copy each list into fresh nodes, moving the edges' iterators along
+        // (a self-loop is listed twice: the copy of src_itr's node takes src_itr, the other one tgt_itr)
+        MyVector<Vertex*> new_vertex_set(n);
+        MyVector<AdjListType* > new_adj_list(n);
+        for(size_t i = 0; i < n; ++ i)
+        {
+            AdjListType* old_list = adj_list[order[i]];
+            AdjListType* list = new AdjListType();
+            for(auto itr = old_list->begin(); itr != old_list->end(); ++itr)
+            {
+                Edge* e = edge_set[edgeID2SetPos(entryEdge(*itr))];
+                auto copy = list->insert(list->end(), *itr);
+                if(itr == e->src_itr)
+                {
+                    e->src_itr = copy;
+                }
+                else
+                {
+                    e->tgt_itr = copy;
+                }
+            }
+            delete old_list;
+            new_vertex_set[i] = vertex_set[order[i]];
+            new_adj_list[i] = list;
+            vertex_map.set(new_vertex_set[i]->id, i);
+        }
+        std::swap(vertex_set, new_vertex_set);
+        std::swap(adj_list, new_adj_list);
+
+        // stable counting sort of the edges by their smaller end position
+        MyVector<size_t> edge_pos(m);
+        MyVector<size_t> start(n + 1);
+        for(size_t i = 0; i <= n; ++ i)
+        {
+            start[i] = 0;
+        }
+        for(size_t i = 0; i < m; ++ i)
+        {
+            size_t pos_s = vertexID2SetPos(edge_set[i]->src);
+            size_t pos_x = vertexID2SetPos(edge_set[i]->tgt);
+            edge_pos[i] = (pos_s < pos_x ? pos_s : pos_x);
+            ++ start[edge_pos[i] + 1];
+        }
+        for(size_t i = 0; i < n; ++ i)
+        {
+            start[i + 1] += start[i];
+        }
+        MyVector<Edge*> new_edge_set(m);
+        for(size_t i = 0; i < m; ++ i)
+        {
+            size_t pos = start[edge_pos[i]] ++;
+            new_edge_set[pos] = edge_set[i];
+            edge_map.set(edge_set[i]->id, pos);
+        }
+        std::swap(edge_set, new_edge_set);
+        conn_index_dirty = true;
+        adj_matrix_dirty = true;
+        return;
+    }
+
+    // returns a snapshot of the instrumentation counters
+    // (all zero unless compiled with MYGRAPH_TRACE_LEVEL >= 1; see MyTrace_c336t319.h)
+    MyGraphCounters counters(void) const
+    {
+        MyGraphCounters c;
+        c.vertex_lookups = cnt_vertex_lookups;
+        c.edge_lookups = cnt_edge_lookups;
+        c.traversal_vertices = cnt_traversal_vertices;
+        c.traversal_edges = cnt_traversal_edges;
+        c.rehashes = edge_index.numRehashes();
+        return c;
+    }
+
+    // resets the instrumentation counters to zero
+    void resetCounters(void)
+    {
+        cnt_vertex_lookups = 0;
+        cnt_edge_lookups = 0;
+        cnt_traversal_vertices = 0;
+        cnt_traversal_edges = 0;
+        edge_index.resetRehashCount();
+        return;
+    }
+
+    // sends the instrumentation counters to the trace sink (category "MyGraph.counters")
+    void reportCounters(void) const
+    {
+        MyGraphCounters c = counters();
+        std::ostringstream os;
+        os << "vertex_lookups=" << c.vertex_lookups << " edge_lookups=" << c.edge_lookups
+           << " traversal_vertices=" << c.traversal_vertices << " traversal_edges=" << c.traversal_edges
+           << " rehashes=" << c.rehashes;
+        MyTrace::emit("MyGraph.counters", os.str());
+        return;
+    }
+
+    // returns the memory footprint of the graph, split by structure (O(n + m); see MyMemory_c336t319.h)
+    MyGraphMemory memoryBreakdown(void) const
+    {
+        MyGraphMemory mem;
+        mem.vertices = vertex_set.memoryUsage() + vertex_set.size() * sizeof(Vertex);
+        for(size_t i = 0; i < vertex_set.size(); ++ i)
+        {
+            mem.vertices += myHeapBytes(vertex_set[i]->data);
+        }
+        mem.edges = edge_set.memoryUsage() + edge_set.size() * sizeof(Edge);
+        for(size_t i = 0; i < edge_set.size(); ++ i)
+        {
+            mem.edges += myHeapBytes(edge_set[i]->data);
+        }
+        mem.adjacency = adj_list.memoryUsage();
+        for(size_t i = 0; i < adj_list.size(); ++ i)
+        {
+            mem.adjacency += sizeof(AdjListType) + adj_list[i]->memoryUsage();
+        }
+        mem.id_maps = vertex_map.memoryUsage() + edge_map.memoryUsage();
+        mem.edge_index = edge_index.memoryUsage();
+        mem.auxiliary = adj_matrix.memoryUsage() + conn_index.memoryUsage() + search_stamp.memoryUsage() + search_dist.memoryUsage();
+        mem.total = sizeof(*this) + mem.vertices + mem.edges + mem.adjacency + mem.id_maps + mem.edge_index + mem.auxiliary;
+        return mem;
+    }
+
+    // returns the total bytes used by the graph (memoryBreakdown().total)
+    size_t memoryUsage(void) const
+    {
+        return memoryBreakdown().total;
+    }
+
+    // sends the memory breakdown of the graph and the process-wide allocation counters to the trace sink (category "MyGraph.memory")
+    // (the allocation counters are all zero unless compiled with MYGRAPH_TRACE_LEVEL >= 1)
+    void reportMemory(void) const
+    {
+        MyGraphMemory mem = memoryBreakdown();
+        MyAllocStats alloc = MyAllocCounter::stats();
+        std::ostringstream os;
+        os << "vertices=" << mem.vertices << " edges=" << mem.edges << " adjacency=" << mem.adjacency
+           << " id_maps=" << mem.id_maps << " edge_index=" << mem.edge_index << " auxiliary=" << mem.auxiliary
+           << " total=" << mem.total << " | allocations=" << alloc.allocations << " deallocations=" << alloc.deallocations
+           << " live_bytes=" << alloc.live_bytes << " peak_bytes=" << alloc.peak_bytes;
+        MyTrace::emit("MyGraph.memory", os.str());
+        return;
+    }
+
+    // returns the number of vertices in the graph
+    size_t numVertices(void) const
+    {
+        return num_vertices;
+    }
+
+    // returns the number of edges in the graph
+    size_t numEdges(void) const
+    {
+        return num_edges;
+    }
+
+    // checks whether the graph is empty (no vertex)
+    bool empty(void) const
+    {
+        return (num_vertices == 0);
+    }
+
+    // prints the content in vertex_set
+    void printInfoVertexSet(void) 
+    {
+        for(size_t i = 0; i < num_vertices; ++ i)
+        {
+            std::cout << "Array Position: " << i << "\t";
+            std::cout << "Vertex ID: " << vertex_set[i]->id << "\t";
+            std::cout << "Vertex data: " << vertex_set[i]->data << std::endl;
+        }
+        return;
+    }
+
+    // prints the content in edge_set
+    void printInfoEdgeSet(void) 
+    {
+        for(size_t i = 0; i < num_edges; ++ i)
+        {
+            std::cout << "Array Position: " << i << "\t";
+            std::cout << "Edge ID: " << edge_set[i]->id << "\t";
+            std::cout << "Edge ends: " << edge_set[i]->src << "\t" << edge_set[i]->tgt << "\t";
+            std::cout << "Edge data: " << edge_set[i]->data << std::endl;
+        }
+        return;
+    }
+
+    // prints the content in vertex_map
+    void printInfoVertexMap(void) 
+    {
+        MyVector<VertexIDType> v_keys;
+        vertex_map.keys(v_keys);
+        MYGRAPH_TRACE("MyGraph", "printInfoVertexMap: vertex_set.size() = " << vertex_set.size()
+                      << ", num_vertices = " << num_vertices << ", vertex_map.size() = " << vertex_map.size());
+        for(size_t i = 0; i < v_keys.size(); ++ i)
+        {
+            std::cout << "VertexID-Position:\t" << v_keys[i] << "\t" << vertexID2SetPos(v_keys[i]) << std::endl;
+        }
+        return;
+    }
+
+    // prints the content in edge_map
+    void printInfoEdgeMap(void) 
+    {
+        MyVector<EdgeIDType> e_keys;
+        edge_map.keys(e_keys);
+        for(size_t i = 0; i < e_keys.size(); ++ i)
+        {
+            std::cout << "EdgeID-Position:\t" << e_keys[i] << "\t" << edgeID2SetPos(e_keys[i]) << std::endl;
+        }
+        return;
+    }
+
+    // prints the content in the adjacency list
+    void printAdjList(void) 
+    {
+        for(size_t i = 0; i < adj_list.size(); ++ i)
+        {
+            std::cout << "Vertex: " << vertex_set[i]->id << " degree: " << degree(vertex_set[i]->id) << "\tIt is connected with: ";
+            for(auto itr = adj_list[i]->begin(); itr != adj_list[i]->end(); ++ itr)
+            {
+                if(vertex_set[i]->id == getEdge(entryEdge(*itr))->src)
+                    std::cout << getEdge(entryEdge(*itr))->tgt << "\t";
+                else if(vertex_set[i]->id == getEdge(entryEdge(*itr))->tgt)
+                    std::cout << getEdge(entryEdge(*itr))->src << "\t";
+                else
+                    throw std::domain_error("MyGraph::printAdjList: edge information may have been corrupted.");
+            }
+            std::cout << std::endl;
+        }
+    }
+
+  private:
+    // the directions a traversal step can take along an edge (they differ only in directed graphs)
+    enum StepDirection
+    {
+        STEP_OUT,       // from the source to the target
+        STEP_IN,        // from the target to the source
+        STEP_ANY        // either way
+    };
+
+    // per-thread output buffer of the parallel traversals
+    // aligned to a cache line, so threads appending to neighbouring buffers do not falsely share
+    struct alignas(64) FrontierBuffer
+    {
+        MyVector<size_t> items;
+    };
+
+    // the lookups made by one chunk of a parallel loop, added to the shared counters once the chunk is done
+    // (counting every lookup on the shared atomics would make the workers contend for them)
+    struct LookupTally
+    {
+        unsigned long long vertex_lookups;
+        unsigned long long edge_lookups;
+
+        LookupTally() : vertex_lookups(0), edge_lookups(0)
+        {
+        }
+    };
+
+    // the simple undirected adjacency with the vertices renumbered by degree, as used by triangle counting
+    // rank r is the r-th vertex by ascending (distinct-neighbour degree, position), and its list holds only its
+    // neighbours of higher rank, as ascending ranks; every triangle is then the common entry w of the lists of its
+    // two lowest-ranked vertices r < s, and no list is longer than sqrt(2m)
+    struct RankedAdjacency
+    {
+        MyVector<size_t> offsets;       // the list of rank r is nbrs[offsets[r]], ..., nbrs[offsets[r + 1] - 1]
+        MyVector<uint32_t> nbrs;
+        MyVector<uint32_t> pos;         // the vertex_set position of each rank
+        MyVector<uint32_t> degree;      // the number of distinct neighbours (other than itself) of each rank
+    };
+
+    // an edge as seen by the minimum spanning forest algorithms
+    struct WeightedEdge
+    {
+        EdgeDataType weight;    // the edge property
+        EdgeIDType id;          // the edge ID
+        size_t pos_s, pos_t;    // the vertex_set positions of the ends (the component labels of the ends in boruvkaForest)
+    };
+
+    VertexIDType current_vertex_ID;                 // the ID to be assigned to the next vertex (ID are assigned based on the order of insertion)
+    EdgeIDType current_edge_ID;                     // the ID to be assigned to the next edge (IDs are assigned based on the order of insertion)
+    size_t num_vertices;                            // the number of vertices
+    size_t num_edges;                               // the number of edges
+    MyVector<Vertex*> vertex_set;                   // the set of vertices
+    MyVector<Edge*> edge_set;                       // the set of edges
+    MyIDMap vertex_map;                             // the mapping between a vertex ID and its index in vertex_set
+    MyIDMap edge_map;                               // the mapping between an edge ID and its index in edge_set
+    MyVector<AdjListType* > adj_list;  // the adjacency list (stores the IDs for the corresponding edges)
+    MyHashTable<EdgeKeyType, EdgeIDType> edge_index;    // the mapping between an edge's endpoint pair (min, max) and its ID
+    MyBitmap adj_matrix;                            // bit (i * adj_matrix_dim + j) is set iff the vertices at positions i and j are adjacent
+    size_t adj_matrix_dim;                          // the number of rows (and columns) of adj_matrix
+    bool adj_matrix_enabled;                        // whether probeEdge consults adj_matrix
+    bool adj_matrix_dirty;                          // whether adj_matrix is invalid (after a vertex deletion, growth, or while disabled)
+    MyDisjointSet conn_index;                       // the connected components over the vertex_set positions
+    bool conn_index_dirty;                          // whether conn_index is invalid (after a deletion, or while disabled)
+    bool conn_index_enabled;                        // whether isConnected may build and use conn_index
+    MyVector<unsigned long long> search_stamp;      // per-position visit marks of the point-to-point searches
+    MyVector<long long> search_dist;                // per-position hop distances of the point-to-point searches
+    unsigned long long search_epoch;                // the number of point-to-point searches started so far
+    // the instrumentation counters (only updated if MYGRAPH_TRACE_LEVEL >= 1)
+    // atomic, since the parallel algorithms add to them too (once per chunk, see LookupTally), with relaxed ordering
+    std::atomic<unsigned long long> cnt_vertex_lookups;
+    std::atomic<unsigned long long> cnt_edge_lookups;
+    std::atomic<unsigned long long> cnt_traversal_vertices;
+    std::atomic<unsigned long long> cnt_traversal_edges;
+    MyGraphLogSink<VertexDataType, EdgeDataType>* mutation_log;   // the attached mutation log (nullptr if none)
+
+    friend class MyGraphLog<VertexDataType, EdgeDataType, GraphPolicy>;
+    friend class MyGraphColumns<VertexDataType, EdgeDataType, GraphPolicy>;
+    friend class MyGraphMatrix<VertexDataType, EdgeDataType, GraphPolicy>;
+
+    // rebuilds conn_index from the edge set if a deletion has invalidated it
+    // union-find cannot split components, so deletions are handled by a lazy O(n + m) rebuild
+    void ensureConnIndex(void)
+    {
+        if(!conn_index_dirty)
+        {
+            return;
+        }
+        MYGRAPH_SPAN("MyGraph", "rebuildConnectivityIndex");
+        conn_index.reset(vertex_set.size());
+        for(size_t i = 0; i < edge_set.size(); ++ i)
+        {
+            conn_index.unite(vertexID2SetPos(edge_set[i]->src), vertexID2SetPos(edge_set[i]->tgt));
+        }
+        conn_index_dirty = false;
+        return;
+    }
+
+    // deletes every vertex, edge and adjacency list and empties the indexes
+    // keeps the settings (connectivity index, adjacency matrix, ID recycling)
+    void releaseAll(void)
+    {
+        for(size_t i = 0; i < vertex_set.size(); ++ i)
+        {
+            delete vertex_set[i];
+        }
+        for(size_t i = 0; i < edge_set.size(); ++ i)
+        {
+            delete edge_set[i];
+        }
+        for(size_t i = 0; i < adj_list.size(); ++ i)
+        {
+            delete adj_list[i];
+        }
+        vertex_set.resize(0);
+        edge_set.resize(0);
+        adj_list.resize(0);
+        vertex_map.clear();
+        edge_map.clear();
+        edge_index.clear();
+        conn_index.reset(0);
+        conn_index_dirty = !conn_index_enabled;
+        adj_matrix_dirty = true;
+        current_vertex_ID = 0;
+        current_edge_ID = 0;
+        num_vertices = 0;
+        num_edges = 0;
+        return;
+    }
+
+    // adds a vertex under the unused ID vid (log replay: reproduces an addVertex whose ID was recorded)
+    void restoreVertex(const VertexIDType vid, VertexDataType && v_data)
+    {
+        if(vid <= 0 || vertex_map.contains(vid))
+        {
+            throw std::domain_error("MyGraph::restoreVertex: vertex ID already in use");
+        }
+        vertex_map.claimFreeID(vid);
+        if(vid > current_vertex_ID)
+        {
+            current_vertex_ID = vid;
+        }
+        Vertex* v = new Vertex(std::move(v_data));
+        v->id = vid;
+        v->tag = 0;
+        vertex_set.push_back(v);
+        size_t pos = vertex_set.size() - 1;
+        vertex_map.insert(vid, pos);
+        adj_list.push_back(new AdjListType());
+        if(pos >= adj_matrix_dim)
+        {
+            adj_matrix_dirty = true;
+        }
+        if(!conn_index_dirty)
+        {
+            conn_index.makeSet();
+        }
+        ++ num_vertices;
+        return;
+    }
+
+    // adds an edge under the unused ID eid (log replay: reproduces an addEdge whose ID was recorded)
+    void restoreEdge(const EdgeIDType eid, const VertexIDType sid, const VertexIDType tid, EdgeDataType && e_data)
+    {
+        if(eid <= 0 || edge_map.contains(eid))
+        {
+            throw std::domain_error("MyGraph::restoreEdge: edge ID already in use");
+        }
+        size_t pos_s = vertexID2SetPos(sid);
+        size_t pos_x = vertexID2SetPos(tid);
+        edge_map.claimFreeID(eid);
+        if(eid > current_edge_ID)
+        {
+            current_edge_ID = eid;
+        }
+        Edge* e = new Edge(sid, tid, std::move(e_data));
+        e->id = eid;
+        e->tag = 0;
+        edge_set.push_back(e);
+        edge_map.insert(eid, edge_set.size() - 1);
+        e->src_itr = adj_list[pos_s]->insert(adj_list[pos_s]->end(), makeEntry(e, true));
+        e->tgt_itr = adj_list[pos_x]->insert(adj_list[pos_x]->end(), makeEntry(e, false));
+        edge_index.insert(HashedObj<EdgeKeyType,EdgeIDType>(edgeKey(sid, tid), eid));
+        if(!adj_matrix_dirty)
+        {
+            markAdjacent(pos_s, pos_x);
+        }
+        if(!conn_index_dirty)
+        {
+            conn_index.unite(pos_s, pos_x);
+        }
+        ++ num_edges;
+        return;
+    }
+
+    // returns the ID for a new vertex: a recycled one if available, the next unused one otherwise
+    VertexIDType nextVertexID(void)
+    {
+        VertexIDType vid;
+        if(vertex_map.popFreeID(vid))
+        {
+            return vid;
+        }
+        return ++current_vertex_ID;
+    }
+
+    // returns the ID for a new edge: a recycled one if available, the next unused one otherwise
+    EdgeIDType nextEdgeID(void)
+    {
+        EdgeIDType eid;
+        if(edge_map.popFreeID(eid))
+        {
+            return eid;
+        }
+        return ++current_edge_ID;
+    }
+
+    // grows vertex_set, adj_list and vertex_map for count more vertices
+    // returns the vertex_set position of the first new vertex
+    size_t reserveVertices(const size_t count)
+    {
+        size_t base = vertex_set.size();
+        vertex_set.reserve(base + count);
+        adj_list.reserve(base + count);
+        vertex_map.reserve(current_vertex_ID + count);
+        return base;
+    }
+
+    // assigns IDs to the vertices appended to vertex_set from position base on,
+    // and gives them their map entries, adjacency lists and connectivity sets
+    // returns the ID of the first new vertex
+    VertexIDType indexNewVertices(const size_t base)
+    {
+        VertexIDType first = current_vertex_ID + 1;
+        for(size_t pos = base; pos < vertex_set.size(); ++ pos)
+        {
+            Vertex* v = vertex_set[pos];
+            v->id = ++current_vertex_ID;
+            v->tag = 0;
+            vertex_map.insert(v->id, pos);
+            adj_list.push_back(new AdjListType());
+            if(!conn_index_dirty)
+            {
+                conn_index.makeSet();
+            }
+            if(mutation_log != nullptr)
+            {
+                mutation_log->logAddVertex(v->id, v->data);
+            }
+        }
+        if(vertex_set.size() > adj_matrix_dim)
+        {
+            adj_matrix_dirty = true;
+        }
+        num_vertices = vertex_set.size();
+        if(mutation_log != nullptr)
+        {
+            mutation_log->logCommit();
+        }
+        return first;
+    }
+
+    // resolves the end vertices of the edges in e_data into end_pos (2 * i: source, 2 * i + 1: target)
+    // and grows edge_set, edge_map and edge_index for them
+    // returns the edge_set position of the first new edge
+    size_t reserveEdges(const MyVector<EdgeRecord>& e_data, MyVector<size_t>& end_pos)
+    {
+        end_pos.resize(2 * e_data.size());
+        for(size_t i = 0; i < e_data.size(); ++ i)
+        {
+            end_pos[2 * i] = vertexID2SetPos(e_data[i].src);
+            end_pos[2 * i + 1] = vertexID2SetPos(e_data[i].tgt);
+        }
+        size_t base = edge_set.size();
+        edge_set.reserve(base + e_data.size());
+        edge_map.reserve(current_edge_ID + e_data.size());
+        edge_index.reserve(edge_index.size() + e_data.size());
+        return base;
+    }
+
+    // assigns IDs to the edges appended to edge_set from position base on and indexes them
+    // links them into the adjacency lists by counting-sorting their ends by vertex position
+    // returns the ID of the first new edge
+    EdgeIDType linkNewEdges(const size_t base, const MyVector<size_t>& end_pos)
+    {
+        EdgeIDType first = current_edge_ID + 1;
+        size_t count = edge_set.size() - base;
+        for(size_t i = 0; i < count; ++ i)
+        {
+            Edge* e = edge_set[base + i];
+            e->id = ++current_edge_ID;
+            e->tag = 0;
+            edge_map.insert(e->id, base + i);
+            edge_index.insert(HashedObj<EdgeKeyType,EdgeIDType>(edgeKey(e->src, e->tgt), e->id));
+            if(!adj_matrix_dirty)
+            {
+                markAdjacent(end_pos[2 * i], end_pos[2 * i + 1]);
+            }
+            if(!conn_index_dirty)
+            {
+                conn_index.unite(end_pos[2 * i], end_pos[2 * i + 1]);
+            }
+            if(mutation_log != nullptr)
+            {
+                mutation_log->logAddEdge(e->id, e->src, e->tgt, e->data);
+            }
+        }
+
+        // counting sort of the edge ends (2 * i + side) by vertex position
+        MyVector<size_t> start(vertex_set.size() + 1);
+        for(size_t p = 0; p <= vertex_set.size(); ++ p)
+        {
+            start[p] = 0;
+        }
+        for(size_t k = 0; k < end_pos.size(); ++ k)
+        {
+            ++ start[end_pos[k] + 1];
+        }
+        for(size_t p = 0; p < vertex_set.size(); ++ p)
+        {
+            start[p + 1] += start[p];
+        }
+        MyVector<size_t> sorted_ends(end_pos.size());
+        for(size_t k = 0; k < end_pos.size(); ++ k)
+        {
+            sorted_ends[start[end_pos[k]] ++] = k;
+        }
+        for(size_t k = 0; k < sorted_ends.size(); ++ k)
+        {
+            size_t end = sorted_ends[k];
+            Edge* e = edge_set[base + end / 2];
+            AdjListType* list = adj_list[end_pos[end]];
+            if(end % 2 == 0)
+            {
+                e->src_itr = list->insert(list->end(), makeEntry(e, true));
+            }
+            else
+            {
+                e->tgt_itr = list->insert(list->end(), makeEntry(e, false));
+            }
+        }
+        num_edges = edge_set.size();
+        if(mutation_log != nullptr)
+        {
+            mutation_log->logCommit();
+        }
+        return first;
+    }
+
+    // deletes the edge specified by eid without telling the log (see deleteEdge)
+    void removeEdge(const EdgeIDType eid)
+    {
+        size_t epos = edgeID2SetPos(eid);
+        Edge* e = edge_set[epos];
+        unlinkEdge(e);
+        delete e;
+
+        size_t last = edge_set.size()-1;
+        if(epos != last)
+        {
+            Edge* back = edge_set[last];
+            edge_set[epos] = back;
+            edge_map.set(back->id, epos);
+        }
+        edge_set.pop_back();
+        edge_map.remove(eid);
+        conn_index_dirty = true;
+        --num_edges;
+        return;
+    }
+
+    // deletes the edges specified by eids without telling the log (see deleteEdges)
+    void removeEdges(const MyVector<EdgeIDType>& eids)
+    {
+        MyVector<size_t> epos(eids.size());
+        for(size_t i = 0; i < eids.size(); ++ i)
+        {
+            epos[i] = edgeID2SetPos(eids[i]);
+        }
+        if(eids.empty())
+        {
+            return;
+        }
+
+        for(size_t i = 0; i < epos.size(); ++ i)
+        {
+            Edge* e = edge_set[epos[i]];
+            if(e == nullptr)
+            {
+                continue;
+            }
+            unlinkEdge(e);
+            edge_map.remove(e->id);
+            delete e;
+            edge_set[epos[i]] = nullptr;
+        }
+        size_t kept = 0;
+        for(size_t i = 0; i < edge_set.size(); ++ i)
+        {
+            if(edge_set[i] != nullptr)
+            {
+                edge_set[kept] = edge_set[i];
+                edge_map.set(edge_set[kept]->id, kept);
+                ++ kept;
+            }
+        }
+        edge_set.resize(kept);
+        num_edges = kept;
+        conn_index_dirty = true;
+        return;
+    }
+
+    // removes edge e from both adjacency lists, edge_index and adj_matrix
+    // if e was the indexed edge of its endpoint pair, a remaining parallel edge (the one with the smallest ID, as load
+    // indexes) takes over the key, found by scanning the shorter of the two adjacency lists; the adj_matrix bits are
+    // cleared only when no edge between the pair remains
+    // leaves e itself, edge_set and edge_map to the caller
+    void unlinkEdge(Edge* e)
+    {
+        size_t pos_s = vertexID2SetPos(e->src);
+        size_t pos_x = vertexID2SetPos(e->tgt);
+        adj_list[pos_s]->erase(e->src_itr);
+        adj_list[pos_x]->erase(e->tgt_itr);
+        EdgeKeyType key = edgeKey(e->src, e->tgt);
+        EdgeIDType indexed;
+        if(edge_index.get(key, indexed) && indexed == e->id)
+        {
+            edge_index.remove(key);
+            AdjListType* shorter = (adj_list[pos_s]->size() <= adj_list[pos_x]->size() ? adj_list[pos_s] : adj_list[pos_x]);
+            bool found = false;
+            EdgeIDType parallel = 0;
+            for(auto itr = shorter->begin(); itr != shorter->end(); ++itr)
+            {
+                Edge* f = getEdge(entryEdge(*itr));
+                if(edgeKey(f->src, f->tgt) == key && (!found || f->id < parallel))
+                {
+                    parallel = f->id;
+                    found = true;
+                }
+            }
+            if(found)
+            {
+                edge_index.insert(HashedObj<EdgeKeyType,EdgeIDType>(key, parallel));
+            }
+            else if(!adj_matrix_dirty)
+            {
+                adj_matrix.reset(pos_s * adj_matrix_dim + pos_x);
+                if(!GraphPolicy::directed)
+                {
+                    adj_matrix.reset(pos_x * adj_matrix_dim + pos_s);
+                }
+            }
+        }
+        return;
+    }
+
+    // returns the edge_index key of the edge between vid1 and vid2 (from vid1 to vid2 in directed graphs)
+    static EdgeKeyType edgeKey(const VertexIDType vid1, const VertexIDType vid2)
+    {
+        return (GraphPolicy::directed || vid1 < vid2 ? EdgeKeyType(vid1, vid2) : EdgeKeyType(vid2, vid1));
+    }
+
+    // sets the adj_matrix bits of an edge between the vertices at pos_s and pos_x (only (pos_s, pos_x) in directed graphs)
+    void markAdjacent(const size_t pos_s, const size_t pos_x)
+    {
+        adj_matrix.set(pos_s * adj_matrix_dim + pos_x);
+        if(!GraphPolicy::directed)
+        {
+            adj_matrix.set(pos_x * adj_matrix_dim + pos_s);
+        }
+        return;
+    }
+
+    // rebuilds adj_matrix from the edge set if it is invalid
+    // leaves room for the graph to double before the next rebuild
+    void ensureAdjMatrix(void)
+    {
+        if(!adj_matrix_dirty)
+        {
+            return;
+        }
+        MYGRAPH_SPAN("MyGraph", "rebuildAdjacencyMatrix");
+        if(adj_matrix_dim < vertex_set.size())
+        {
+            adj_matrix_dim = 2 * vertex_set.size();
+        }
+        adj_matrix.resize(adj_matrix_dim * adj_matrix_dim);
+        for(size_t i = 0; i < edge_set.size(); ++ i)
+        {
+            markAdjacent(vertexID2SetPos(edge_set[i]->src), vertexID2SetPos(edge_set[i]->tgt));
+        }
+        adj_matrix_dirty = false;
+        return;
+    }
+
+    // returns the edge ID of an adjacency entry
+    static EdgeIDType entryEdge(const EdgeIDType eid)
+    {
+        return eid;
+    }
+
+    static EdgeIDType entryEdge(const MyNeighborEntry& entry)
+    {
+        return entry.eid;
+    }
+
+    // returns the adjacency entry of edge e for the list of its source end (at_src) or of its target end
+    AdjEntryType makeEntry(const Edge* e, const bool at_src) const
+    {
+        return makeEntry(e, at_src, static_cast<AdjEntryType*>(nullptr));
+    }
+
+    static EdgeIDType makeEntry(const Edge* e, const bool, EdgeIDType*)
+    {
+        return e->id;
+    }
+
+    static MyNeighborEntry makeEntry(const Edge* e, const bool at_src, MyNeighborEntry*)
+    {
+        MyNeighborEntry entry;
+        entry.eid = e->id;
+        entry.nbr = (at_src ? e->tgt : e->src);
+        entry.out = (at_src || !GraphPolicy::directed);
+        return entry;
+    }
+
+    // checks whether a step in direction dir from the vertex at pos_u may use the adjacency entry
+    // (always true in undirected graphs)
+    bool entryLeads(const size_t pos_u, const EdgeIDType eid, const StepDirection dir)
+    {
+        if(!GraphPolicy::directed || dir == STEP_ANY)
+        {
+            return true;
+        }
+        Edge* e = getEdge(eid);
+        return (dir == STEP_OUT ? e->src : e->tgt) == vertex_set[pos_u]->id;
+    }
+
+    bool entryLeads(const size_t, const MyNeighborEntry& entry, const StepDirection dir)
+    {
+        return !GraphPolicy::directed || dir == STEP_ANY || entry.out == (dir == STEP_OUT);
+    }
+
+    // if a step in direction dir from the vertex at pos_u may use the adjacency entry,
+    // stores the vertex_set position of the other end in pos_w and returns true
+    // plain edge IDs have to look up the edge and compare its ends; inline entries carry the other end and the direction
+    // parallel workers pass their tally for the lookups (see LookupTally)
+    bool stepEntry(const size_t pos_u, const EdgeIDType eid, const StepDirection dir, size_t& pos_w, LookupTally* tally = nullptr)
+    {
+        Edge* e = edge_set[edgeID2SetPos(eid, tally)];
+        VertexIDType u = vertex_set[pos_u]->id;
+        if(GraphPolicy::directed && dir != STEP_ANY && (dir == STEP_OUT ? e->src : e->tgt) != u)
+        {
+            return false;
+        }
+        pos_w = vertexID2SetPos(e->src == u ? e->tgt : e->src, tally);
+        return true;
+    }
+
+    bool stepEntry(const size_t, const MyNeighborEntry& entry, const StepDirection dir, size_t& pos_w, LookupTally* tally = nullptr)
+    {
+        if(GraphPolicy::directed && dir != STEP_ANY && entry.out != (dir == STEP_OUT))
+        {
+            return false;
+        }
+        pos_w = vertexID2SetPos(entry.nbr, tally);
+        return true;
+    }
+
+    // fills order with the vertex_set positions by descending degree (ties in position order)
+    void degreeOrder(MyVector<size_t>& order)
+    {
+        size_t n = vertex_set.size();
+        size_t max_degree = 0;
+        for(size_t i = 0; i < n; ++ i)
+        {
+            max_degree = std::max(max_degree, static_cast<size_t>(adj_list[i]->size()));
+        }
+        MyVector<size_t> start(max_degree + 2);
+        for(size_t d = 0; d < start.size(); ++ d)
+        {
+            start[d] = 0;
+        }
+        for(size_t i = 0; i < n; ++ i)
+        {
+            ++ start[max_degree - adj_list[i]->size() + 1];
+        }
+        for(size_t d = 0; d <= max_degree; ++ d)
+        {
+            start[d + 1] += start[d];
+        }
+        order.resize(n);
+        for(size_t i = 0; i < n; ++ i)
+        {
+            order[start[max_degree - adj_list[i]->size()] ++] = i;
+        }
+        return;
+    }
+
+    // sizes out to one entry per vertex ID handed out so far (plus entry 0) and sets every entry to value
+    template <typename T>
+    void fillByID(MyVector<T>& out, const T value, MyThreadPool& pool)
+    {
+        size_t num_ids = static_cast<size_t>(current_vertex_ID) + 1;
+        out.resize(num_ids);
+        pool.parallelFor(0, num_ids, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                out[i] = value;
+            }
+        });
+        return;
+    }
+
+    // builds ranked (see RankedAdjacency) in parallel on the threads of pool
+    // throws std::domain_error if the positions do not fit in 32 bits
+    void buildRankedAdjacency(RankedAdjacency& ranked, MyThreadPool& pool)
+    {
+        size_t n = vertex_set.size();
+        if(n > UINT32_MAX)
+        {
+            throw std::domain_error("MyGraph buildRankedAdjacency: too many vertices");
+        }
+        // the sorted distinct neighbours of every position, without itself (in the first degree[u] slots of its range)
+        MyVector<size_t> full_offsets(n + 1);
+        full_offsets[0] = 0;
+        for(size_t u = 0; u < n; ++ u)
+        {
+            full_offsets[u + 1] = full_offsets[u] + adj_list[u]->size();
+        }
+        MyVector<uint32_t> full(full_offsets[n]);
+        MyVector<uint32_t> degree(n);
+        pool.parallelFor(0, n, 256, [&](size_t, size_t lo, size_t hi)
+        {
+            LookupTally tally;
+            for(size_t u = lo; u < hi; ++ u)
+            {
+                size_t d = 0;
+                for(auto itr = adj_list[u]->begin(); itr != adj_list[u]->end(); ++itr)
+                {
+                    size_t w;
+                    if(stepEntry(u, *itr, STEP_ANY, w, &tally) && w != u)
+                    {
+                        full[full_offsets[u] + d ++] = static_cast<uint32_t>(w);
+                    }
+                }
+                uint32_t* list = full.begin() + full_offsets[u];
+                std::sort(list, list + d);
+                degree[u] = static_cast<uint32_t>(std::unique(list, list + d) - list);
+            }
+            addLookups(tally);
+        });
+
+        // ranks by ascending degree (ties in position order), with a counting sort
+        size_t max_degree = 0;
+        for(size_t u = 0; u < n; ++ u)
+        {
+            max_degree = std::max(max_degree, static_cast<size_t>(degree[u]));
+        }
+        MyVector<size_t> start(max_degree + 2);
+        for(size_t d = 0; d < start.size(); ++ d)
+        {
+            start[d] = 0;
+        }
+        for(size_t u = 0; u < n; ++ u)
+        {
+            ++ start[degree[u] + 1];
+        }
+        for(size_t d = 0; d <= max_degree; ++ d)
+        {
+            start[d + 1] += start[d];
+        }
+        MyVector<uint32_t> pos(n);
+        MyVector<uint32_t> rank(n);
+        for(size_t u = 0; u < n; ++ u)
+        {
+            rank[u] = static_cast<uint32_t>(start[degree[u]] ++);
+            pos[rank[u]] = static_cast<uint32_t>(u);
+        }
+
+        // keeps the neighbours of higher rank, as ranks
+        MyVector<size_t> offsets(n + 1);
+        offsets[0] = 0;
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t r = lo; r < hi; ++ r)
+            {
+                size_t u = pos[r];
+                size_t cnt = 0;
+                for(size_t k = full_offsets[u]; k < full_offsets[u] + degree[u]; ++ k)
+                {
+                    cnt += (rank[full[k]] > r);
+                }
+                offsets[r + 1] = cnt;
+            }
+        });
+        for(size_t r = 0; r < n; ++ r)
+        {
+            offsets[r + 1] += offsets[r];
+        }
+        MyVector<uint32_t> nbrs(offsets[n]);
+        MyVector<uint32_t> ranked_degree(n);
+        pool.parallelFor(0, n, 256, [&](size_t, size_t lo, size_t hi)
+        {
+            for(size_t r = lo; r < hi; ++ r)
+            {
+                size_t u = pos[r];
+                size_t d = offsets[r];
+                for(size_t k = full_offsets[u]; k < full_offsets[u] + degree[u]; ++ k)
+                {
+                    if(rank[full[k]] > r)
+                    {
+                        nbrs[d ++] = rank[full[k]];
+                    }
+                }
+                std::sort(nbrs.begin() + offsets[r], nbrs.begin() + d);
+                ranked_degree[r] = degree[u];
+            }
+        });
+        ranked.offsets = std::move(offsets);
+        ranked.nbrs = std::move(nbrs);
+        ranked.pos = std::move(pos);
+        ranked.degree = std::move(ranked_degree);
         return;
     }
 
-    // prints the content in vertex_map
-    void printInfoVertexMap(void) 
+    // the order of the minimum spanning forest algorithms: by weight, equal weights by edge ID
+    static bool lighterEdge(const WeightedEdge& a, const WeightedEdge& b)
     {
-        MyVector<VertexIDType> v_keys;
-        vertex_map.keys(v_keys);
-        //adding
-        
-        std::cerr 
-        << "DEBUG: vertex_set.size()=" << vertex_set.size()
-        << "  num_vertices="    << num_vertices
-        << "  vertex_map.size()="<< vertex_map.size()
-        << "\n";
+        if(a.weight < b.weight)
+        {
+            return true;
+        }
+        if(b.weight < a.weight)
+        {
+            return false;
+        }
+        return a.id < b.id;
+    }
 
-        for(size_t i = 0; i < v_keys.size(); ++ i)
+    // copies src[lo, hi) to dst[lo, hi), the elements satisfying pred first and then the others, each in their order;
+    // returns the number satisfying pred
+    // counts and copies in fixed chunks on the threads of pool, with the chunk offsets from a prefix sum
+    template <typename T, typename PredType>
+    static size_t partitionInto(const MyVector<T>& src, MyVector<T>& dst, const size_t lo, const size_t hi, PredType pred,
+                                MyThreadPool& pool)
+    {
+        const size_t PARTITION_CHUNK = 4096;
+        if(hi <= lo)
+        {
+            return 0;
+        }
+        size_t num_chunks = (hi - lo + PARTITION_CHUNK - 1) / PARTITION_CHUNK;
+        MyVector<size_t> kept(num_chunks + 1);
+        // a pool without workers hands out the whole range at once; it is split the same way
+        pool.parallelFor(lo, hi, PARTITION_CHUNK, [&](size_t, size_t a, size_t b)
+        {
+            for(size_t c = a; c < b; c += PARTITION_CHUNK)
+            {
+                size_t cnt = 0;
+                for(size_t i = c; i < std::min(b, c + PARTITION_CHUNK); ++ i)
+                {
+                    cnt += (pred(src[i]) ? 1 : 0);
+                }
+                kept[(c - lo) / PARTITION_CHUNK + 1] = cnt;
+            }
+        });
+        kept[0] = 0;
+        for(size_t c = 0; c < num_chunks; ++ c)
         {
-            std::cerr 
-                << "  key["<<i<<"]="<< v_keys[i] 
-                << "  maps to pos="<< vertexID2SetPos(v_keys[i])
-                << "\n";
+            kept[c + 1] += kept[c];
         }
+        size_t total = kept[num_chunks];
+        pool.parallelFor(lo, hi, PARTITION_CHUNK, [&](size_t, size_t a, size_t b)
+        {
+            for(size_t c = a; c < b; c += PARTITION_CHUNK)
+            {
+                size_t chunk = (c - lo) / PARTITION_CHUNK;
+                size_t yes = lo + kept[chunk];
+                size_t no = lo + total + (c - lo) - kept[chunk];
+                for(size_t i = c; i < std::min(b, c + PARTITION_CHUNK); ++ i)
+                {
+                    if(pred(src[i]))
+                    {
+                        dst[yes ++] = src[i];
+                    }
+                    else
+                    {
+                        dst[no ++] = src[i];
+                    }
+                }
+            }
+        });
+        return total;
+    }
 
-        //
-        for(size_t i = 0; i < v_keys.size(); ++ i)
+    // parallel Boruvka over the edge array: every round, each component picks its lightest edge to another one
+    // (an atomic compare-and-swap per end keeps the lightest), hooks itself along it, and the hooks are shortened
+    // to the new roots by pointer jumping; edges inside a component are dropped, so the array shrinks every round
+    // the order is total, so the hooks form trees apart from pairs of components that picked the same edge,
+    // where the component with the smaller label stays the root; at most log2(n) rounds
+    void boruvkaForest(MyVector<WeightedEdge>& edges, MyVector<EdgeIDType>& forest, MyThreadPool& pool)
+    {
+        const size_t NONE = static_cast<size_t>(-1);
+        size_t n = vertex_set.size();
+        size_t m = edges.size();
+        MyVector<size_t> comp(n);       // the label of the component of each position (the position of its root)
+        std::unique_ptr<std::atomic<size_t>[]> best(new std::atomic<size_t>[n]);   // the lightest edge of each root
+        std::unique_ptr<std::atomic<size_t>[]> hook(new std::atomic<size_t>[n]);   // the root each root is hooked to
+        pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
         {
-            std::cout << "VertexID-Position:\t" << v_keys[i] << "\t" << vertexID2SetPos(v_keys[i]) << std::endl;
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                comp[i] = i;
+            }
+        });
+        MyVector<WeightedEdge> buffer(m);
+        MyVector<MyVector<EdgeIDType> > picked(pool.numThreads());
+        while(true)
+        {
+            // the ends as component labels; the edges inside a component are dropped
+            pool.parallelFor(0, m, 4096, [&](size_t, size_t lo, size_t hi)
+            {
+                for(size_t i = lo; i < hi; ++ i)
+                {
+                    edges[i].pos_s = comp[edges[i].pos_s];
+                    edges[i].pos_t = comp[edges[i].pos_t];
+                }
+            });
+            m = partitionInto(edges, buffer, 0, m, [](const WeightedEdge& e) { return e.pos_s != e.pos_t; }, pool);
+            std::swap(edges, buffer);
+            if(m == 0)
+            {
+                break;
+            }
+
+            pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+            {
+                for(size_t i = lo; i < hi; ++ i)
+                {
+                    best[i].store(NONE, std::memory_order_relaxed);
+                }
+            });
+            // keeps the lighter of the edges i and best[c] in best[c]
+            auto offer = [&](const size_t c, const size_t i)
+            {
+                size_t cur = best[c].load(std::memory_order_relaxed);
+                while(cur == NONE || lighterEdge(edges[i], edges[cur]))
+                {
+                    if(best[c].compare_exchange_weak(cur, i, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+            };
+            pool.parallelFor(0, m, 4096, [&](size_t, size_t lo, size_t hi)
+            {
+                for(size_t i = lo; i < hi; ++ i)
+                {
+                    offer(edges[i].pos_s, i);
+                    offer(edges[i].pos_t, i);
+                }
+            });
+
+            for(size_t t = 0; t < picked.size(); ++ t)
+            {
+                picked[t].resize(0);
+            }
+            pool.parallelFor(0, n, 4096, [&](size_t tid, size_t lo, size_t hi)
+            {
+                for(size_t c = lo; c < hi; ++ c)
+                {
+                    if(comp[c] != c)
+                    {
+                        continue;
+                    }
+                    size_t i = best[c].load(std::memory_order_relaxed);
+                    if(i == NONE)
+                    {
+                        hook[c].store(c, std::memory_order_relaxed);
+                        continue;
+                    }
+                    size_t d = (edges[i].pos_s == c ? edges[i].pos_t : edges[i].pos_s);
+                    if(c < d && best[d].load(std::memory_order_relaxed) == i)
+                    {
+                        hook[c].store(c, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        hook[c].store(d, std::memory_order_relaxed);
+                        picked[tid].push_back(edges[i].id);
+                    }
+                }
+            });
+            for(size_t t = 0; t < picked.size(); ++ t)
+            {
+                for(size_t k = 0; k < picked[t].size(); ++ k)
+                {
+                    forest.push_back(picked[t][k]);
+                }
+            }
+
+            // pointer jumping: a hook only ever moves to a root further up, so concurrent jumps stay on the path
+            bool changed = true;
+            while(changed)
+            {
+                std::atomic<bool> any(false);
+                pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+                {
+                    bool moved = false;
+                    for(size_t c = lo; c < hi; ++ c)
+                    {
+                        if(comp[c] != c)
+                        {
+                            continue;
+                        }
+                        size_t up = hook[c].load(std::memory_order_relaxed);
+                        size_t upup = hook[up].load(std::memory_order_relaxed);
+                        if(up != upup)
+                        {
+                            hook[c].store(upup, std::memory_order_relaxed);
+                            moved = true;
+                        }
+                    }
+                    if(moved)
+                    {
+                        any.store(true, std::memory_order_relaxed);
+                    }
+                });
+                changed = any.load(std::memory_order_relaxed);
+            }
+            pool.parallelFor(0, n, 4096, [&](size_t, size_t lo, size_t hi)
+            {
+                for(size_t i = lo; i < hi; ++ i)
+                {
+                    comp[i] = hook[comp[i]].load(std::memory_order_relaxed);
+                }
+            });
         }
         return;
     }
 
-    // prints the content in edge_map
-    void printInfoEdgeMap(void) 
+    // filter-Kruskal (Osipov et al.) on edges[lo, hi), with buffer as the scratch space of the same range
+    // splits the edges at a median-of-three pivot, runs on the lighter part first, then drops the heavier edges whose
+    // ends sets already connects (read-only finds, in parallel) and runs on the rest; small ranges are sorted for Kruskal
+    void filterKruskal(MyVector<WeightedEdge>& edges, MyVector<WeightedEdge>& buffer, const size_t lo, const size_t hi,
+                       MyDisjointSet& sets, MyVector<EdgeIDType>& forest, MyThreadPool& pool)
     {
-        MyVector<EdgeIDType> e_keys;
-        edge_map.keys(e_keys);
-        for(size_t i = 0; i < e_keys.size(); ++ i)
+        const size_t KRUSKAL_BASE = 1 << 14;
+        if(hi - lo <= KRUSKAL_BASE)
         {
-            std::cout << "EdgeID-Position:\t" << e_keys[i] << "\t" << edgeID2SetPos(e_keys[i]) << std::endl;
+            if(hi > lo)
+            {
+                std::sort(edges.begin() + lo, edges.begin() + hi, lighterEdge);
+            }
+            for(size_t i = lo; i < hi; ++ i)
+            {
+                if(sets.unite(edges[i].pos_s, edges[i].pos_t))
+                {
+                    forest.push_back(edges[i].id);
+                }
+            }
+            return;
+        }
+        // the median of three distinct edges is lighter than one of them, so both parts are smaller than the range
+        const WeightedEdge& a = edges[lo];
+        const WeightedEdge& b = edges[lo + (hi - lo) / 2];
+        const WeightedEdge& c = edges[hi - 1];
+        WeightedEdge pivot;
+        if(lighterEdge(a, b))
+        {
+            pivot = (lighterEdge(b, c) ? b : (lighterEdge(a, c) ? c : a));
+        }
+        else
+        {
+            pivot = (lighterEdge(a, c) ? a : (lighterEdge(b, c) ? c : b));
         }
+        size_t light = partitionInto(edges, buffer, lo, hi, [&](const WeightedEdge& e) { return !lighterEdge(pivot, e); }, pool);
+        filterKruskal(buffer, edges, lo, lo + light, sets, forest, pool);
+        size_t kept = partitionInto(buffer, edges, lo + light, hi, [&](const WeightedEdge& e)
+        {
+            return sets.root(e.pos_s) != sets.root(e.pos_t);
+        }, pool);
+        filterKruskal(edges, buffer, lo + light, lo + light + kept, sets, forest, pool);
         return;
     }
 
-    // prints the content in the adjacency list
-    void printAdjList(void) 
+    // counts the triangles of ranked in parallel on the threads of pool, and returns their number
+    // unless per_rank is nullptr, also adds to per_rank[r] the number of triangles at rank r
+    unsigned long long rankedTriangles(const RankedAdjacency& ranked, std::atomic<unsigned long long>* per_rank, MyThreadPool& pool)
     {
-        for(size_t i = 0; i < adj_list.size(); ++ i)
+        size_t n = ranked.pos.size();
+        if(ranked.nbrs.size() == 0)
         {
-            std::cout << "Vertex: " << vertex_set[i]->id << " degree: " << degree(vertex_set[i]->id) << "\tIt is connected with: ";
-            for(auto itr = adj_list[i]->begin(); itr != adj_list[i]->end(); ++ itr)
+            return 0;
+        }
+        const uint32_t* nbrs = &ranked.nbrs[0];
+        std::atomic<unsigned long long> total(0);
+        // the lists grow with the rank, so the chunks are small to keep the threads balanced
+        pool.parallelFor(0, n, 64, [&](size_t, size_t lo, size_t hi)
+        {
+            unsigned long long found = 0;
+            for(size_t r = lo; r < hi; ++ r)
             {
-                if(vertex_set[i]->id == getEdge(*itr)->src)
-                    std::cout << getEdge(*itr)->tgt << "\t";
-                else if(vertex_set[i]->id == getEdge(*itr)->tgt)
-                    std::cout << getEdge(*itr)->src << "\t";
-                else
-                    throw std::domain_error("MyGraph::printAdjList: edge information may have been corrupted.");
+                const uint32_t* list_r = nbrs + ranked.offsets[r];
+                size_t d_r = ranked.offsets[r + 1] - ranked.offsets[r];
+                unsigned long long at_r = 0;
+                for(size_t k = 0; k < d_r; ++ k)
+                {
+                    // the third vertex has a higher rank than s = list_r[k], so only the rest of list_r can hold it
+                    size_t s = list_r[k];
+                    const uint32_t* list_s = nbrs + ranked.offsets[s];
+                    size_t d_s = ranked.offsets[s + 1] - ranked.offsets[s];
+                    size_t common;
+                    if(per_rank == nullptr)
+                    {
+                        common = MySetIntersection::count(list_r + k + 1, d_r - k - 1, list_s, d_s);
+                    }
+                    else
+                    {
+                        common = MySetIntersection::forEach(list_r + k + 1, d_r - k - 1, list_s, d_s, [&](uint32_t w)
+                        {
+                            per_rank[w].fetch_add(1, std::memory_order_relaxed);
+                        });
+                        if(common > 0)
+                        {
+                            per_rank[s].fetch_add(common, std::memory_order_relaxed);
+                        }
+                    }
+                    at_r += common;
+                }
+                if(per_rank != nullptr && at_r > 0)
+                {
+                    per_rank[r].fetch_add(at_r, std::memory_order_relaxed);
+                }
+                found += at_r;
             }
-            std::cout << std::endl;
+            total.fetch_add(found, std::memory_order_relaxed);
+        });
+        MYGRAPH_COUNT(cnt_traversal_vertices, n);
+        MYGRAPH_COUNT(cnt_traversal_edges, ranked.nbrs.size());
+        return total.load(std::memory_order_relaxed);
+    }
+
+    // fills order with the vertex_set positions in breadth-first order, one component after the other
+    // plain: from the highest-degree vertex of each component, neighbours in adjacency list order
+    // rcm: reverse Cuthill-McKee; from a pseudo-peripheral vertex of each component, the newly reached
+    // neighbours of every vertex by ascending degree, and the whole order reversed at the end
+    void breadthFirstOrder(MyVector<size_t>& order, const bool rcm)
+    {
+        size_t n = vertex_set.size();
+        MyVector<size_t> seeds;
+        degreeOrder(seeds);
+        MyBitmap visited(n);
+        MyVector<size_t> stamp(n);          // the George-Liu rounds that reached each position
+        for(size_t i = 0; i < n; ++ i)
+        {
+            stamp[i] = 0;
+        }
+        size_t round = 0;
+        MyVector<size_t> levels;
+        order.resize(0);
+        order.reserve(n);
+        for(size_t k = 0; k < n; ++ k)
+        {
+            // Cuthill-McKee starts from the low degrees, so it walks the seeds backwards
+            size_t seed = (rcm ? seeds[n - 1 - k] : seeds[k]);
+            if(visited.test(seed))
+            {
+                continue;
+            }
+            if(rcm)
+            {
+                seed = peripheralPos(seed, stamp, round, levels);
+            }
+            visited.set(seed);
+            order.push_back(seed);
+            // order doubles as the queue
+            for(size_t head = order.size() - 1; head < order.size(); ++ head)
+            {
+                size_t u = order[head];
+                size_t first = order.size();
+                for(auto itr = adj_list[u]->begin(); itr != adj_list[u]->end(); ++itr)
+                {
+                    size_t w;
+                    stepEntry(u, *itr, STEP_ANY, w);
+                    if(!visited.test(w))
+                    {
+                        visited.set(w);
+                        order.push_back(w);
+                    }
+                }
+                if(rcm)
+                {
+                    std::sort(order.begin() + first, order.end(), [&](const size_t a, const size_t b)
+                    {
+                        return adj_list[a]->size() < adj_list[b]->size() || (adj_list[a]->size() == adj_list[b]->size() && a < b);
+                    });
+                }
+            }
+        }
+        if(rcm)
+        {
+            std::reverse(order.begin(), order.end());
         }
+        return;
     }
 
-  private:
-    VertexIDType current_vertex_ID;                 // the ID to be assigned to the next vertex (ID are assigned based on the order of insertion)
-    EdgeIDType current_edge_ID;                     // the ID to be assigned to the next edge (IDs are assigned based on the order of insertion)
-    size_t num_vertices;                            // the number of vertices
-    size_t num_edges;                               // the number of edges
-    MyVector<Vertex*> vertex_set;                   // the set of vertices
-    MyVector<Edge*> edge_set;                       // the set of edges
-    MyHashTable<VertexIDType, size_t> vertex_map;   // the mapping between a vertex ID and its index in vertex_set
-    MyHashTable<EdgeIDType, size_t> edge_map;       // the mapping between an edge ID and its index in vertex_set
-    MyVector<MyLinkedList<EdgeIDType>* > adj_list;  // the adjacency list (stores the IDs for the corresponding edges)
+    // returns a pseudo-peripheral vertex position of the component of pos (George and Liu):
+    // repeats a BFS from the lowest-degree vertex of the last level while the number of levels grows
+    // stamp, round and queue are scratch space kept across the components
+    size_t peripheralPos(size_t pos, MyVector<size_t>& stamp, size_t& round, MyVector<size_t>& queue)
+    {
+        size_t eccentricity = 0;
+        while(true)
+        {
+            ++ round;
+            queue.resize(0);
+            queue.push_back(pos);
+            stamp[pos] = round;
+            size_t last_level = 0;
+            size_t depth = 0;
+            size_t head = 0;
+            while(true)
+            {
+                size_t level_end = queue.size();
+                for(; head < level_end; ++ head)
+                {
+                    size_t u = queue[head];
+                    for(auto itr = adj_list[u]->begin(); itr != adj_list[u]->end(); ++itr)
+                    {
+                        size_t w;
+                        stepEntry(u, *itr, STEP_ANY, w);
+                        if(stamp[w] != round)
+                        {
+                            stamp[w] = round;
+                            queue.push_back(w);
+                        }
+                    }
+                }
+                if(queue.size() == level_end)
+                {
+                    break;
+                }
+                last_level = level_end;
+                ++ depth;
+            }
+            if(depth <= eccentricity)
+            {
+                return pos;
+            }
+            eccentricity = depth;
+            pos = queue[last_level];
+            for(size_t i = last_level + 1; i < queue.size(); ++ i)
+            {
+                if(adj_list[queue[i]]->size() < adj_list[pos]->size())
+                {
+                    pos = queue[i];
+                }
+            }
+        }
+    }
+
+    // direction-optimizing BFS from the vertex at pos_src (Beamer et al.)
+    // top-down steps expand the frontier; bottom-up steps let every unvisited vertex look for a parent in the frontier
+    // switches to bottom-up once the frontier's edges outnumber 1/BFS_ALPHA of the unexplored edges,
+    // and back to top-down once the frontier holds fewer than 1/BFS_BETA of the vertices and is shrinking
+    void directionOptimizingBFS(const size_t pos_src, MyVector<VertexIDType>& path)
+    {
+        const size_t BFS_ALPHA = 14;
+        const size_t BFS_BETA = 24;
+        size_t n = vertex_set.size();
+        MyBitmap visited(n);
+        MyBitmap in_frontier(n);
+        MyVector<size_t> frontier;
+        MyVector<size_t> next;
+
+        path.resize(0);
+        path.reserve(n);
+        visited.set(pos_src);
+        frontier.push_back(pos_src);
+        path.push_back(vertex_set[pos_src]->id);
+        size_t scanned = 0;
+        size_t edges_unexplored = 2 * num_edges - adj_list[pos_src]->size();
+        size_t edges_frontier = adj_list[pos_src]->size();
+        bool bottom_up = false;
+        while(!frontier.empty())
+        {
+            if(!bottom_up && edges_frontier > edges_unexplored / BFS_ALPHA)
+            {
+                bottom_up = true;
+            }
+            else if(bottom_up && frontier.size() < n / BFS_BETA && frontier.size() < next.size())
+            {
+                bottom_up = false;
+            }
+
+            next.resize(0);
+            if(!bottom_up)
+            {
+                for(size_t i = 0; i < frontier.size(); ++ i)
+                {
+                    size_t u = frontier[i];
+                    scanned += adj_list[u]->size();
+                    for(auto itr = adj_list[u]->begin(); itr != adj_list[u]->end(); ++itr)
+                    {
+                        size_t w;
+                        if(stepEntry(u, *itr, STEP_OUT, w) && !visited.test(w))
+                        {
+                            visited.set(w);
+                            next.push_back(w);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                for(size_t i = 0; i < frontier.size(); ++ i)
+                {
+                    in_frontier.set(frontier[i]);
+                }
+                // only the unvisited vertices search for a parent; skip fully visited words
+                for(size_t wd = 0; wd < visited.numWords(); ++ wd)
+                {
+                    unsigned long long unvisited = ~visited.word(wd);
+                    while(unvisited != 0)
+                    {
+                        size_t w = 64 * wd + __builtin_ctzll(unvisited);
+                        unvisited &= unvisited - 1;
+                        if(w >= n)
+                        {
+                            break;
+                        }
+                        for(auto itr = adj_list[w]->begin(); itr != adj_list[w]->end(); ++itr)
+                        {
+                            ++ scanned;
+                            size_t parent;
+                            if(stepEntry(w, *itr, STEP_IN, parent) && in_frontier.test(parent))
+                            {
+                                visited.set(w);
+                                next.push_back(w);
+                                break;
+                            }
+                        }
+                    }
+                }
+                for(size_t i = 0; i < frontier.size(); ++ i)
+                {
+                    in_frontier.reset(frontier[i]);
+                }
+            }
+
+            edges_frontier = 0;
+            for(size_t i = 0; i < next.size(); ++ i)
+            {
+                path.push_back(vertex_set[next[i]]->id);
+                edges_frontier += adj_list[next[i]]->size();
+            }
+            edges_unexplored -= edges_frontier;
+            // next keeps the previous frontier so the shrink test above can compare level sizes
+            std::swap(frontier, next);
+        }
+        MYGRAPH_COUNT(cnt_traversal_vertices, path.size());
+        MYGRAPH_COUNT(cnt_traversal_edges, scanned);
+        return;
+    }
+
+    // starts a new search over search_stamp/search_dist
+    // stamps from earlier searches compare below the returned base, so nothing has to be cleared
+    unsigned long long beginSearch(void)
+    {
+        size_t old_size = search_stamp.size();
+        if(old_size < vertex_set.size())
+        {
+            search_stamp.resize(vertex_set.size());
+            search_dist.resize(vertex_set.size());
+            for(size_t i = old_size; i < search_stamp.size(); ++ i)
+            {
+                search_stamp[i] = 0;
+            }
+        }
+        ++ search_epoch;
+        return 2 * search_epoch;
+    }
+
+    // bidirectional BFS between the vertices at pos_1 and pos_2
+    // alternates whole levels, always expanding the side with the smaller frontier,
+    // and stops at the first level in which the two searches meet
+    // in directed graphs, follow_direction searches for a path from pos_1 to pos_2 (the pos_2 side walks edges backwards);
+    // otherwise directions are ignored
+    // returns the hop distance, or -1 if the vertices are not connected
+    long long bidirectionalSearch(const size_t pos_1, const size_t pos_2, const bool follow_direction)
+    {
+        if(pos_1 == pos_2)
+        {
+            return 0;
+        }
+        const StepDirection dir[2] = { follow_direction ? STEP_OUT : STEP_ANY, follow_direction ? STEP_IN : STEP_ANY };
+        unsigned long long base = beginSearch();
+        MyVector<size_t> frontier[2];
+        MyVector<size_t> next;
+        search_stamp[pos_1] = base;
+        search_stamp[pos_2] = base + 1;
+        search_dist[pos_1] = 0;
+        search_dist[pos_2] = 0;
+        frontier[0].push_back(pos_1);
+        frontier[1].push_back(pos_2);
+        while(!frontier[0].empty() && !frontier[1].empty())
+        {
+            size_t side = (frontier[0].size() <= frontier[1].size() ? 0 : 1);
+            long long best = -1;
+            next.resize(0);
+            for(size_t i = 0; i < frontier[side].size(); ++ i)
+            {
+                size_t u = frontier[side][i];
+                MYGRAPH_COUNT(cnt_traversal_vertices, 1);
+                MYGRAPH_COUNT(cnt_traversal_edges, adj_list[u]->size());
+                for(auto itr = adj_list[u]->begin(); itr != adj_list[u]->end(); ++itr)
+                {
+                    size_t w;
+                    if(!stepEntry(u, *itr, dir[side], w))
+                    {
+                        continue;
+                    }
+                    if(search_stamp[w] == base + 1 - side)
+                    {
+                        long long d = search_dist[u] + 1 + search_dist[w];
+                        if(best < 0 || d < best)
+                        {
+                            best = d;
+                        }
+                    }
+                    else if(search_stamp[w] != base + side)
+                    {
+                        search_stamp[w] = base + side;
+                        search_dist[w] = search_dist[u] + 1;
+                        next.push_back(w);
+                    }
+                }
+            }
+            if(best >= 0)
+            {
+                return best;
+            }
+            std::swap(frontier[side], next);
+        }
+        return -1;
+    }
 
     // maps the vertex ID to its position in the vertex_set array
-    size_t vertexID2SetPos(const VertexIDType vid)
+    // the lookup is counted in tally if one is given (see LookupTally), otherwise in the shared counter
+    size_t vertexID2SetPos(const VertexIDType vid, LookupTally* tally = nullptr)
     {
         // code begins
         size_t pos;
-        std::cerr << "DEBUG: Lookin gup vertex id = " <<vid  << " and total len of " << num_vertices << std::endl;
+        if(tally != nullptr)
+        {
+            MYGRAPH_COUNT(tally->vertex_lookups, 1);
+        }
+        else
+        {
+            MYGRAPH_COUNT(cnt_vertex_lookups, 1);
+        }
         if(!vertex_map.get(vid,pos))
         {
             throw std::out_of_range("MyGraph vertexID2SetPos: vertex ID not found");
@@ -648,10 +3266,19 @@ class MyGraph
     }
 
     // maps the edge ID to its position in the edge_set array
-    size_t edgeID2SetPos(const VertexIDType eid)
+    // the lookup is counted in tally if one is given (see LookupTally), otherwise in the shared counter
+    size_t edgeID2SetPos(const VertexIDType eid, LookupTally* tally = nullptr)
     {
         // code begins
         size_t pos;
+        if(tally != nullptr)
+        {
+            MYGRAPH_COUNT(tally->edge_lookups, 1);
+        }
+        else
+        {
+            MYGRAPH_COUNT(cnt_edge_lookups, 1);
+        }
         if(!edge_map.get(eid, pos))
         {
             throw std::out_of_range("MyGraph edgeID2SetPos: edge ID not found");
@@ -660,11 +3287,18 @@ class MyGraph
         // code ends
     }
 
+    // adds the lookups counted by a finished chunk of a parallel loop to the shared counters
+    void addLookups(const LookupTally& tally)
+    {
+        MYGRAPH_COUNT(cnt_vertex_lookups, tally.vertex_lookups);
+        MYGRAPH_COUNT(cnt_edge_lookups, tally.edge_lookups);
+    }
+
     // gets the vertex ID for one in a given position in the vertex_set array
     VertexIDType vertexSetPos2ID(const size_t vpos)
     {
         // code begins
-        std::cerr << "DEBUG: vpos = " << vpos << ", num_vertices = " << num_vertices <<std::endl;
+        MYGRAPH_TRACE("MyGraph", "vertexSetPos2ID: vpos = " << vpos << ", num_vertices = " << num_vertices);
         if(vpos >= num_vertices)
         {
             throw std::out_of_range("MyGraph vertexSetPos2ID: vpos >= num_vertices");
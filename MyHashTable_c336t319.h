@@ -6,9 +6,11 @@
 #include <cmath>
 #include <algorithm>
 #include <string>
+#include <utility>
 
 #include "MyVector_c336t319.h"
 #include "MyLinkedList_c336t319.h"
+#include "MyTrace_c336t319.h"
 
 static const long long uh_param_a = 53;       // universal hash function parameter a
 static const long long uh_param_b = 97;       // universal hash function parameter b
@@ -58,17 +60,48 @@ class HashFunc<std::string>
   public:    
     long long univHash(const std::string& key, const long long table_size) const
     {
-        long long hv = 0;
+        // accumulate unsigned (wrap-around is well defined), then reduce below the Mersenne prime,
+        // so long keys can neither overflow nor produce a negative bucket
+        unsigned long long acc = 0;
         for(size_t i = 0; i < key.length(); ++ i)
         {
-            hv = param_base * hv + static_cast<long long>(key[i]);
+            acc = param_base * acc + static_cast<unsigned char>(key[i]);
         }
+        long long hv = static_cast<long long>(acc % mersenne_prime);
         hv = fastMersenneModulo(static_cast<long long>(uh_param_a * hv + uh_param_b));
         hv = hv % table_size;
         return hv;
     }
 };
 
+// the hash function class that supports the hashing of "std::pair<long long, long long>" keys
+// (e.g., the endpoint pair of an edge)
+// the halves are combined and mixed at full 64-bit width (the splitmix64 finalizer), so large tables use all of their
+// buckets; folding through mersenne_prime would cap the hash at 2^19 - 1 values
+template <>
+class HashFunc<std::pair<long long, long long> >
+{
+  private:
+    static const unsigned long long param_mult = 0x9E3779B97F4A7C15ULL;     // the golden-ratio multiplier spreading the first half
+
+    static unsigned long long mix(unsigned long long x)
+    {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ULL;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+  public:
+    long long univHash(const std::pair<long long, long long>& key, const long long table_size) const
+    {
+        unsigned long long hv = mix(static_cast<unsigned long long>(key.first) * param_mult ^ static_cast<unsigned long long>(key.second));
+        return static_cast<long long>(hv % static_cast<unsigned long long>(table_size));
+    }
+};
+
 // definition of the template hashed object class
 template <typename KeyType, typename ValueType>
 class HashedObj
@@ -116,6 +149,7 @@ class MyHashTable
     size_t theSize; // the number of data elements stored in the hash table
     MyVector<MyLinkedList<HashedObj<KeyType, ValueType> >* > hash_table;    // the hash table implementing the separate chaining approach
     MyVector<size_t> primes;    // a set of precomputed and sorted prime numbers
+    unsigned long long theRehashes; // the number of rehashes performed (counted if MYGRAPH_TRACE_LEVEL >= 1)
 
     // pre-calculate a set of primes using the sieve of Eratosthenes algorithm
     // will be called if table doubling requires a larger prime number for table size
@@ -123,6 +157,7 @@ class MyHashTable
     void preCalPrimes(const size_t n)
     {
         // code begins
+        primes.resize(0);
         std::vector<bool> prime(n+1, true);
         for(size_t p = 2; p*p <= n; p++)
         {
@@ -153,6 +188,12 @@ class MyHashTable
         {
             throw std::runtime_error("Error: primes list is empty.");
         }
+        // extend the sieve instead of capping the table at the largest precomputed prime,
+        // which would make every later insert rehash the full table
+        if (n > primes.back())
+        {
+            preCalPrimes(2 * n);
+        }
     
         auto it = std::lower_bound(primes.begin(), primes.end(), n);
         if (it != primes.end()) 
@@ -187,6 +228,9 @@ class MyHashTable
     void rehash(const size_t new_size)
     {
         // code begins
+        MYGRAPH_SPAN("MyHashTable", "rehash");
+        MYGRAPH_COUNT(theRehashes, 1);
+        MYGRAPH_TRACE("MyHashTable", "rehash: " << hash_table.size() << " -> " << new_size << " buckets, " << theSize << " elements");
         size_t oldSize = theSize;
         MyVector<MyLinkedList<HashedObj<KeyType, ValueType> > * > tmp_hash_table(new_size);
         for(size_t i = 0; i < tmp_hash_table.size(); ++ i)
@@ -245,6 +289,7 @@ class MyHashTable
             hash_table[i] = new MyLinkedList<HashedObj<KeyType, ValueType> >;
         }
         theSize = 0;
+        theRehashes = 0;
         return;
         // code ends
     }
@@ -261,6 +306,34 @@ class MyHashTable
         // code ends
     }
 
+    // removes all data elements
+    // sizes the table so that expected_size elements can be inserted afterwards without rehashing
+    void clear(const size_t expected_size = 0)
+    {
+        for(size_t i = 0; i < hash_table.size(); ++i)
+        {
+            delete hash_table[i];
+        }
+        size_t new_size = nextPrime(2 * expected_size + 3);
+        hash_table.resize(new_size);
+        for(size_t i = 0; i < new_size; ++ i)
+        {
+            hash_table[i] = new MyLinkedList<HashedObj<KeyType, ValueType> >;
+        }
+        theSize = 0;
+        return;
+    }
+
+    // grows the table so that n data elements in total can be held without further rehashing
+    void reserve(const size_t n)
+    {
+        if(2 * n >= hash_table.size())
+        {
+            rehash(nextPrime(2 * n + 3));
+        }
+        return;
+    }
+
     // checks if the hash tabel contains the given key
     bool contains(const KeyType& key)
     {
@@ -393,13 +466,43 @@ class MyHashTable
         // code ends
     }
 
+    // returns the number of rehashes performed so far (always 0 unless MYGRAPH_TRACE_LEVEL >= 1)
+    unsigned long long numRehashes() const
+    {
+        return theRehashes;
+    }
+
+    // resets the rehash counter
+    void resetRehashCount()
+    {
+        theRehashes = 0;
+    }
+
+    // returns the heap bytes of the bucket array, the bucket lists with their nodes, and the prime table
+    // (not counting memory owned by the keys and values)
+    size_t memoryUsage() const
+    {
+        size_t bytes = hash_table.memoryUsage() + primes.memoryUsage();
+        for(size_t i = 0; i < hash_table.size(); ++ i)
+        {
+            bytes += sizeof(MyLinkedList<HashedObj<KeyType, ValueType> >) + hash_table[i]->memoryUsage();
+        }
+        return bytes;
+    }
+
+    // retrieves the value stored under key without copying the key
+    // safe to call from several threads at once as long as no thread modifies the table
     bool get(const KeyType& key, ValueType& out_value) const
     {
-        HashedObj<KeyType, ValueType> holder;
-        if(retrieve(key, holder))
+        HashFunc<KeyType> hash_func;
+        long long bucket = hash_func.univHash(key, static_cast<long long>(hash_table.size()));
+        for(auto itr = hash_table[bucket] -> begin(); itr != hash_table[bucket] -> end(); ++ itr)
         {
-            out_value = std::move(holder.value);
-            return true;
+            if((*itr).key == key)
+            {
+                out_value = (*itr).value;
+                return true;
+            }
         }
         return false;
     }
@@ -412,7 +515,7 @@ class MyHashTable
             auto* bucket = hash_table[i];
             for(auto itr = bucket->begin(); itr != bucket->end(); ++itr)
             {
-                std::cerr << "Debug keys: bucket = " << i<< " key= " << (*itr).key << std::endl;
+                MYGRAPH_TRACE("MyHashTable", "keys: bucket = " << i << " key = " << (*itr).key);
                 out_keys.push_back((*itr).key);
             }
         }
@@ -0,0 +1,211 @@
+#ifndef __MYIDMAP_H__
+#define __MYIDMAP_H__
+
+#include <cstdlib>
+
+#include "MyVector_c336t319.h"
+
+// maps the densely assigned IDs 1, 2, 3, ... to array positions
+// the position of ID i is kept directly in slots[i], so a lookup is a single array load
+// with recycling turned on, removed IDs are kept in a free list for reuse, which bounds the array under churn
+class MyIDMap
+{
+  private:
+    MyVector<size_t> slots;         // slots[id] is the position mapped to id, or NOT_FOUND
+    size_t theSize;                 // the number of IDs currently mapped
+    bool recycling;                 // whether removed IDs are collected in free_ids
+    MyVector<long long> free_ids;   // the removed IDs available for reuse (used as a stack)
+
+    // makes slots large enough to hold id; new slots are unmapped
+    void grow(const long long id)
+    {
+        size_t old_size = slots.size();
+        if(static_cast<size_t>(id) < old_size)
+        {
+            return;
+        }
+        size_t new_size = (old_size == 0 ? 16 : old_size);
+        while(new_size <= static_cast<size_t>(id))
+        {
+            new_size *= 2;
+        }
+        slots.reserve(new_size);
+        slots.resize(new_size);
+        for(size_t i = old_size; i < new_size; ++ i)
+        {
+            slots[i] = NOT_FOUND;
+        }
+        return;
+    }
+
+  public:
+
+    static const size_t NOT_FOUND = static_cast<size_t>(-1);     // the slot value of an unmapped ID
+
+    // default constructor
+    MyIDMap() :
+        slots(0),
+        theSize(0),
+        recycling(false),
+        free_ids(0)
+    {
+        return;
+    }
+
+    // maps id to pos; IDs must be positive
+    // returns true if id was not mapped yet, false otherwise
+    bool insert(const long long id, const size_t pos)
+    {
+        grow(id);
+        if(slots[id] != NOT_FOUND)
+        {
+            return false;
+        }
+        slots[id] = pos;
+        ++ theSize;
+        return true;
+    }
+
+    // changes the position of an already mapped id
+    void set(const long long id, const size_t pos)
+    {
+        slots[id] = pos;
+        return;
+    }
+
+    // retrieves the position mapped to id
+    // returns true if id is mapped, false otherwise
+    bool get(const long long id, size_t& pos) const
+    {
+        if(id <= 0 || static_cast<size_t>(id) >= slots.size() || slots[id] == NOT_FOUND)
+        {
+            return false;
+        }
+        pos = slots[id];
+        return true;
+    }
+
+    // checks whether id is mapped
+    bool contains(const long long id) const
+    {
+        size_t pos;
+        return get(id, pos);
+    }
+
+    // unmaps id (and keeps it for reuse if recycling is on)
+    // returns true if id was mapped, false otherwise
+    bool remove(const long long id)
+    {
+        if(!contains(id))
+        {
+            return false;
+        }
+        slots[id] = NOT_FOUND;
+        -- theSize;
+        if(recycling)
+        {
+            free_ids.push_back(id);
+        }
+        return true;
+    }
+
+    // removes all mappings and forgets the recycled IDs
+    // makes room for the IDs up to max_id
+    void clear(const long long max_id = 0)
+    {
+        for(size_t i = 0; i < slots.size(); ++ i)
+        {
+            slots[i] = NOT_FOUND;
+        }
+        grow(max_id);
+        theSize = 0;
+        free_ids.resize(0);
+        return;
+    }
+
+    // makes room for the IDs up to max_id, so inserting them does not grow the array
+    void reserve(const long long max_id)
+    {
+        grow(max_id);
+        return;
+    }
+
+    // turns the collection of removed IDs on or off (turning it off drops the collected IDs)
+    void setRecycling(const bool enabled)
+    {
+        recycling = enabled;
+        if(!enabled)
+        {
+            free_ids.resize(0);
+        }
+        return;
+    }
+
+    // takes a removed ID for reuse
+    // returns false if recycling is off or no removed ID is available
+    bool popFreeID(long long& id)
+    {
+        if(free_ids.empty())
+        {
+            return false;
+        }
+        id = free_ids.back();
+        free_ids.pop_back();
+        return true;
+    }
+
+    // takes id off the list of removed IDs (if it is there), so it is not handed out again
+    // the list is searched from the most recently removed ID on
+    void claimFreeID(const long long id)
+    {
+        for(size_t i = free_ids.size(); i > 0; -- i)
+        {
+            if(free_ids[i - 1] == id)
+            {
+                for(size_t j = i; j < free_ids.size(); ++ j)
+                {
+                    free_ids[j - 1] = free_ids[j];
+                }
+                free_ids.pop_back();
+                return;
+            }
+        }
+        return;
+    }
+
+    // returns the number of IDs currently mapped
+    size_t size() const
+    {
+        return theSize;
+    }
+
+    // returns the number of slots (one more than the largest ID that fits without growing)
+    size_t capacity() const
+    {
+        return slots.size();
+    }
+
+    // collects the mapped IDs in ascending order
+    void keys(MyVector<long long>& out_keys) const
+    {
+        out_keys.resize(0);
+        out_keys.reserve(theSize);
+        for(size_t i = 1; i < slots.size(); ++ i)
+        {
+            if(slots[i] != NOT_FOUND)
+            {
+                out_keys.push_back(static_cast<long long>(i));
+            }
+        }
+        return;
+    }
+
+    // returns the heap bytes of the slot array and the free list
+    size_t memoryUsage() const
+    {
+        return slots.memoryUsage() + free_ids.memoryUsage();
+    }
+
+};
+
+#endif // __MYIDMAP_H__
@@ -4,12 +4,14 @@
 #include <algorithm>
 #include <iostream>
 
+#include "MyMemory_c336t319.h"
+
 template <typename DataType>
-class MyLinkedList
+class MyLinkedList : public MyCountedObject
 {
   private:
     
-    struct Node
+    struct Node : public MyCountedObject
     {
         DataType  data;
         Node   *prev;
@@ -285,9 +287,7 @@ class MyLinkedList
         std::swap(this -> theSize, rhs.theSize);
         std::swap(this -> head, rhs.head);
         std::swap(this -> tail, rhs.tail);
-        rhs.theSize = 0;
-        rhs.head = nullptr;
-        rhs.tail = nullptr;
+        // rhs now owns the old nodes of this list and releases them in its destructor
         return *this;
         // code ends
     }
@@ -337,6 +337,16 @@ class MyLinkedList
         // code ends
     }
 
+    // returns the heap bytes of the nodes (including the two sentinels; not counting memory owned by the elements)
+    size_t memoryUsage() const
+    {
+        if(head == nullptr)
+        {
+            return 0;
+        }
+        return (static_cast<size_t>(theSize) + 2) * sizeof(Node);
+    }
+
     // checks if the linked list is empty; return True if empty, false otherwise
     bool empty( ) const
     { 
@@ -0,0 +1,158 @@
+#ifndef __MYMAPPEDFILE_H__
+#define __MYMAPPEDFILE_H__
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MYGRAPH_HAVE_MMAP 1
+#else
+#define MYGRAPH_HAVE_MMAP 0
+#endif
+
+// the expected access pattern of a part of a mapped file (see MyMappedFile::advise)
+enum MyAccessHint
+{
+    ACCESS_NORMAL,          // the kernel's default read-ahead
+    ACCESS_SEQUENTIAL,      // read in ascending order; aggressive read-ahead, pages may be dropped soon after use
+    ACCESS_RANDOM,          // scattered reads; no read-ahead
+    ACCESS_WILLNEED,        // will be read soon; start reading it in now
+    ACCESS_DONTNEED         // not needed for now; the pages may be dropped
+};
+
+// read-only view of a whole file
+// memory-maps the file where mmap is available and falls back to reading it into a buffer otherwise
+class MyMappedFile
+{
+  private:
+    const char* theData;        // the first byte of the file contents
+    size_t theSize;             // the number of bytes
+    bool mapped;                // whether theData is a mapping (otherwise it points into buffer)
+    std::string buffer;         // the file contents if the file is not mapped
+
+  public:
+
+    // default constructor; opens nothing
+    MyMappedFile() :
+        theData(nullptr),
+        theSize(0),
+        mapped(false)
+    {
+        return;
+    }
+
+    // destructor; unmaps the file
+    ~MyMappedFile()
+    {
+        close();
+    }
+
+    MyMappedFile(const MyMappedFile&) = delete;
+    MyMappedFile& operator=(const MyMappedFile&) = delete;
+
+    // maps (or reads) the file at path
+    // returns false if the file cannot be opened
+    bool open(const std::string& path)
+    {
+        close();
+#if MYGRAPH_HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            return false;
+        }
+        struct stat st;
+        if(fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if(p != MAP_FAILED)
+            {
+                madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                theData = static_cast<const char*>(p);
+                theSize = static_cast<size_t>(st.st_size);
+                mapped = true;
+                ::close(fd);
+                return true;
+            }
+        }
+        ::close(fd);
+#endif
+        // empty files, special files and platforms without mmap
+        std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+        if(!in.is_open())
+        {
+            return false;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        theData = buffer.data();
+        theSize = buffer.size();
+        return true;
+    }
+
+    // releases the mapping or the buffer
+    void close()
+    {
+#if MYGRAPH_HAVE_MMAP
+        if(mapped)
+        {
+            munmap(const_cast<char*>(theData), theSize);
+        }
+#endif
+        theData = nullptr;
+        theSize = 0;
+        mapped = false;
+        buffer.clear();
+        return;
+    }
+
+    // tells the kernel how the bytes [offset, offset + length) will be accessed
+    // does nothing if the file is not mapped (it is then already in memory)
+    void advise(const size_t offset, const size_t length, const MyAccessHint hint) const
+    {
+#if MYGRAPH_HAVE_MMAP
+        if(!mapped || offset >= theSize || length == 0)
+        {
+            return;
+        }
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t begin = offset - offset % page;
+        size_t end = (offset + length < theSize ? offset + length : theSize);
+        int advice = MADV_NORMAL;
+        switch(hint)
+        {
+            case ACCESS_SEQUENTIAL: advice = MADV_SEQUENTIAL; break;
+            case ACCESS_RANDOM: advice = MADV_RANDOM; break;
+            case ACCESS_WILLNEED: advice = MADV_WILLNEED; break;
+            case ACCESS_DONTNEED: advice = MADV_DONTNEED; break;
+            default: break;
+        }
+        madvise(const_cast<char*>(theData) + begin, end - begin, advice);
+#else
+        (void)offset;
+        (void)length;
+        (void)hint;
+#endif
+        return;
+    }
+
+    // returns the first byte of the file contents
+    const char* data() const
+    {
+        return theData;
+    }
+
+    // returns the number of bytes
+    size_t size() const
+    {
+        return theSize;
+    }
+
+};
+
+#endif // __MYMAPPEDFILE_H__
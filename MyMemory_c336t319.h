@@ -0,0 +1,144 @@
+#ifndef __MYMEMORY_H__
+#define __MYMEMORY_H__
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// the instrumentation level (see MyTrace_c336t319.h); allocations are counted if MYGRAPH_TRACE_LEVEL >= 1
+#ifndef MYGRAPH_TRACE_LEVEL
+#define MYGRAPH_TRACE_LEVEL 0
+#endif
+
+// reports the allocation or the release of the block at ptr (bytes long) to MyAllocCounter
+// null pointers (e.g. the storage of a moved-from container) are ignored
+#if MYGRAPH_TRACE_LEVEL >= 1
+#define MYGRAPH_COUNT_ALLOC(ptr, bytes) ((ptr) != nullptr ? MyAllocCounter::onAlloc(bytes) : (void)0)
+#define MYGRAPH_COUNT_FREE(ptr, bytes) ((ptr) != nullptr ? MyAllocCounter::onFree(bytes) : (void)0)
+#else
+#define MYGRAPH_COUNT_ALLOC(ptr, bytes) ((void)0)
+#define MYGRAPH_COUNT_FREE(ptr, bytes) ((void)0)
+#endif
+
+// a snapshot of the allocation counters
+// all fields stay zero unless MYGRAPH_TRACE_LEVEL >= 1
+struct MyAllocStats
+{
+    unsigned long long allocations;     // the number of allocations so far
+    unsigned long long deallocations;   // the number of releases so far
+    unsigned long long live_bytes;      // the bytes currently allocated
+    unsigned long long peak_bytes;      // the largest live_bytes seen (since the last resetPeak)
+};
+
+// process-wide counters of the memory allocated by the containers and the graph
+// fed by the MyVector storage hooks and by the class-specific operator new/delete of MyCountedObject;
+// memory allocated by element types themselves (e.g. the buffer of a std::string) is not seen
+class MyAllocCounter
+{
+  public:
+    // records an allocation of bytes
+    static void onAlloc(const size_t bytes)
+    {
+        counters().allocations.fetch_add(1, std::memory_order_relaxed);
+        unsigned long long live = counters().live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        unsigned long long peak = counters().peak_bytes.load(std::memory_order_relaxed);
+        while(live > peak && !counters().peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+        return;
+    }
+
+    // records the release of bytes
+    static void onFree(const size_t bytes)
+    {
+        counters().deallocations.fetch_add(1, std::memory_order_relaxed);
+        counters().live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+        return;
+    }
+
+    // returns a snapshot of the counters
+    static MyAllocStats stats()
+    {
+        MyAllocStats s;
+        s.allocations = counters().allocations.load(std::memory_order_relaxed);
+        s.deallocations = counters().deallocations.load(std::memory_order_relaxed);
+        s.live_bytes = counters().live_bytes.load(std::memory_order_relaxed);
+        s.peak_bytes = counters().peak_bytes.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // restarts the peak from the current live bytes (e.g. to measure the peak of one phase)
+    static void resetPeak()
+    {
+        counters().peak_bytes.store(counters().live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return;
+    }
+
+  private:
+    struct Counters
+    {
+        std::atomic<unsigned long long> allocations;
+        std::atomic<unsigned long long> deallocations;
+        std::atomic<unsigned long long> live_bytes;
+        std::atomic<unsigned long long> peak_bytes;
+    };
+
+    // the counters (a function-local static, so every translation unit shares them)
+    static Counters& counters()
+    {
+        static Counters c = {{0}, {0}, {0}, {0}};
+        return c;
+    }
+};
+
+// base class of the heap-allocated nodes and objects (list nodes, lists, vertices, edges)
+// routes their new/delete through MyAllocCounter; empty, so it adds no size to the derived class
+struct MyCountedObject
+{
+#if MYGRAPH_TRACE_LEVEL >= 1
+    static void* operator new(const size_t bytes)
+    {
+        void* p = ::operator new(bytes);
+        MyAllocCounter::onAlloc(bytes);
+        return p;
+    }
+
+    static void operator delete(void* p, const size_t bytes)
+    {
+        MyAllocCounter::onFree(bytes);
+        ::operator delete(p);
+    }
+#endif
+};
+
+// returns the heap bytes owned by a data element beyond its own size
+// (the elements of the containers and the vertex/edge properties of the graph)
+template <typename DataType>
+size_t myHeapBytes(const DataType&)
+{
+    return 0;
+}
+
+// a std::string owns a buffer once it outgrows the small-string storage inside the object
+inline size_t myHeapBytes(const std::string& s)
+{
+    static const size_t inline_capacity = std::string().capacity();
+    return (s.capacity() > inline_capacity ? s.capacity() + 1 : 0);
+}
+
+// the memory footprint of a graph, split by structure (in bytes)
+// vertex and edge objects include their properties' heap buffers as far as myHeapBytes sees them;
+// allocator overhead per block is not included
+struct MyGraphMemory
+{
+    size_t vertices;        // vertex_set and the Vertex objects
+    size_t edges;           // edge_set and the Edge objects
+    size_t adjacency;       // adj_list, the per-vertex lists and their nodes (including the sentinels)
+    size_t id_maps;         // vertex_map and edge_map
+    size_t edge_index;      // the endpoint-pair hash table (buckets, bucket lists, nodes and prime table)
+    size_t auxiliary;       // the adjacency matrix, the connectivity index and the search scratch arrays
+    size_t total;           // the sum of the above plus the graph object itself
+};
+
+#endif // __MYMEMORY_H__
@@ -22,10 +22,24 @@ class MyQueue //: private MyVector<DataType>
     }
 
     // requests for newCapacity amount of space
+    // the ring buffer spans all myVec.size() slots (one always stays free), so growing it
+    // copies the queued elements to the front of a larger array in queue order
     void reserve(size_t newCapacity)
     {
         // code begins
-        myVec.reserve(newCapacity);
+        if(newCapacity <= myVec.size())
+        {
+            return;
+        }
+        size_t n = size();
+        MyVector<DataType> tmp(newCapacity);
+        for(size_t i = 0; i < n; ++ i)
+        {
+            tmp[i] = std::move(myVec[(dataStart + i) % myVec.size()]);
+        }
+        myVec = std::move(tmp);
+        dataStart = 0;
+        dataEnd = n;
         // code ends
     }
 
@@ -110,20 +124,12 @@ class MyQueue //: private MyVector<DataType>
     void enqueue(const DataType & x)
     {
         // code begins
-        if((size() == myVec.capacity()-1))
+        if(size() + 1 >= myVec.size())
         {
-            reserve(myVec.capacity()*2);
+            reserve(2 * myVec.size() + 2);
         }
         myVec[dataEnd] = x;
-        if(myVec.capacity() == 0)
-        {
-            reserve(1);
-        }
-        if(size() == myVec.capacity()-1)
-        {
-            reserve(myVec.capacity()*2);
-        }
-        dataEnd = (dataEnd + 1) % myVec.capacity();
+        dataEnd = (dataEnd + 1) % myVec.size();
         // code ends
     }
 
@@ -131,13 +137,12 @@ class MyQueue //: private MyVector<DataType>
     void enqueue(DataType && x)
     {
         // code begins
-        if((dataEnd + 1) % myVec.capacity() == dataStart)
+        if(size() + 1 >= myVec.size())
         {
-            reserve(myVec.capacity()*2);
+            reserve(2 * myVec.size() + 2);
         }
         myVec[dataEnd] = std::move(x);
-        dataEnd = (dataEnd + 1) % myVec.capacity();
-        
+        dataEnd = (dataEnd + 1) % myVec.size();
         // code ends
     }
 
@@ -149,7 +154,7 @@ class MyQueue //: private MyVector<DataType>
         {
             return;
         }
-        dataStart = (dataStart + 1) % myVec.capacity();
+        dataStart = (dataStart + 1) % myVec.size();
         // code ends
     }
 
@@ -177,18 +182,24 @@ class MyQueue //: private MyVector<DataType>
         {
             return dataEnd - dataStart;
         }
-        return myVec.capacity() - dataStart + dataEnd;
+        return myVec.size() - dataStart + dataEnd;
         // code ends
     }
 
-    // access the capacity of the queue
+    // access the capacity of the queue (the number of elements it holds without growing)
     size_t capacity(void) const 
     {
         // code begins
-        return myVec.capacity();
+        return (myVec.size() == 0 ? 0 : myVec.size() - 1);
         // code ends
     }
 
+    // returns the heap bytes of the ring buffer (not counting memory owned by the elements)
+    size_t memoryUsage(void) const
+    {
+        return myVec.memoryUsage();
+    }
+
 };
 
 
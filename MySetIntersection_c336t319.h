@@ -0,0 +1,162 @@
+#ifndef __MYSETINTERSECTION_H__
+#define __MYSETINTERSECTION_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MYGRAPH_HAVE_SSE2_INTERSECT 1
+#else
+#define MYGRAPH_HAVE_SSE2_INTERSECT 0
+#endif
+
+// intersection of two ascending arrays of distinct 32-bit values (e.g. sorted neighbour lists)
+// lists of similar length are merged four by four with SSE2 (Schlegel et al., Lemire et al.): a block of four values
+// of a is compared against all four rotations of a block of b at once, and the block with the smaller last value moves on;
+// without SSE2, and for the tails, a scalar merge is used
+// when one list is more than SKEW_RATIO times longer, every value of the shorter one is searched for instead
+class MySetIntersection
+{
+  public:
+
+    // returns the number of values in both a[0], ..., a[na - 1] and b[0], ..., b[nb - 1]
+    static size_t count(const uint32_t* a, const size_t na, const uint32_t* b, const size_t nb)
+    {
+        return intersect<false>(a, na, b, nb, [](uint32_t) { return; });
+    }
+
+    // calls func(x) for every value x in both a and b, in ascending order; returns their number
+    template <typename FuncType>
+    static size_t forEach(const uint32_t* a, const size_t na, const uint32_t* b, const size_t nb, FuncType func)
+    {
+        return intersect<true>(a, na, b, nb, func);
+    }
+
+    // returns whether the blocks are compared with SSE2 in this build
+    static bool simdIntersect()
+    {
+        return MYGRAPH_HAVE_SSE2_INTERSECT != 0;
+    }
+
+  private:
+
+    static const size_t SKEW_RATIO = 32;
+
+    template <bool Report, typename FuncType>
+    static size_t intersect(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, FuncType func)
+    {
+        if(na > nb)
+        {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+        if(na == 0)
+        {
+            return 0;
+        }
+        if(na * SKEW_RATIO < nb)
+        {
+            return intersectSkewed<Report>(a, na, b, nb, func);
+        }
+        size_t i = 0, j = 0, found = 0;
+#if MYGRAPH_HAVE_SSE2_INTERSECT
+        found += intersectBlocks<Report>(a, na, b, nb, i, j, func);
+#endif
+        while(i < na && j < nb)
+        {
+            if(a[i] < b[j])
+            {
+                ++ i;
+            }
+            else if(b[j] < a[i])
+            {
+                ++ j;
+            }
+            else
+            {
+                if(Report)
+                {
+                    func(a[i]);
+                }
+                ++ found;
+                ++ i;
+                ++ j;
+            }
+        }
+        return found;
+    }
+
+    // searches every value of the short list a in the long list b, narrowing the range of b as it goes
+    template <bool Report, typename FuncType>
+    static size_t intersectSkewed(const uint32_t* a, const size_t na, const uint32_t* b, const size_t nb, FuncType& func)
+    {
+        size_t found = 0;
+        const uint32_t* lo = b;
+        const uint32_t* end = b + nb;
+        for(size_t i = 0; i < na && lo != end; ++ i)
+        {
+            lo = std::lower_bound(lo, end, a[i]);
+            if(lo != end && *lo == a[i])
+            {
+                if(Report)
+                {
+                    func(a[i]);
+                }
+                ++ found;
+                ++ lo;
+            }
+        }
+        return found;
+    }
+
+#if MYGRAPH_HAVE_SSE2_INTERSECT
+    // merges whole blocks of four from a[i] and b[j] on; leaves i and j at the first values not yet compared
+    // the values are distinct, so a match is found in exactly one pair of blocks
+    template <bool Report, typename FuncType>
+    static size_t intersectBlocks(const uint32_t* a, const size_t na, const uint32_t* b, const size_t nb,
+                                  size_t& i, size_t& j, FuncType& func)
+    {
+        size_t found = 0;
+        while(i + 4 <= na && j + 4 <= nb)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+            __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                                                   _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+                                      _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4e)),
+                                                   _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+            // one bit per lane of va that matched a lane of vb
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+            if(mask != 0)
+            {
+                found += __builtin_popcount(static_cast<unsigned>(mask));
+                if(Report)
+                {
+                    for(size_t k = 0; k < 4; ++ k)
+                    {
+                        if(mask & (1 << k))
+                        {
+                            func(a[i + k]);
+                        }
+                    }
+                }
+            }
+            uint32_t a_last = a[i + 3];
+            uint32_t b_last = b[j + 3];
+            if(a_last <= b_last)
+            {
+                i += 4;
+            }
+            if(b_last <= a_last)
+            {
+                j += 4;
+            }
+        }
+        return found;
+    }
+#endif
+};
+
+#endif // __MYSETINTERSECTION_H__
@@ -0,0 +1,467 @@
+#ifndef __MYSNAPSHOT_H__
+#define __MYSNAPSHOT_H__
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "MyVector_c336t319.h"
+
+// the binary snapshot format of MyGraph (see MyGraph::save / MyGraph::load)
+//
+// [MySnapshotHeader][section 0][section 1]...; every section starts at a multiple of 8 bytes
+// all numbers are stored in the byte order of the writing machine (load checks endian_check)
+// n = num_vertices, m = num_edges; vertices and edges are stored in the order of the graph's vertex_set / edge_set
+//
+//   SNAP_VERTEX_IDS       int64[n]     the vertex IDs
+//   SNAP_VERTEX_TAGS      int32[n]     the vertex tags
+//   SNAP_VERTEX_DATA      fixed-size data: the raw values, vertex_data_bytes each;
+//                         string data: uint64[n + 1] offsets into SNAP_VERTEX_BLOB (value i is [off[i], off[i + 1]))
+//   SNAP_VERTEX_BLOB      the bytes of the string values (empty for fixed-size data)
+//   SNAP_EDGE_IDS         int64[m]     the edge IDs
+//   SNAP_EDGE_SRC         int64[m]     the source vertex IDs
+//   SNAP_EDGE_TGT         int64[m]     the target vertex IDs
+//   SNAP_EDGE_TAGS        int32[m]     the edge tags
+//   SNAP_EDGE_DATA        as SNAP_VERTEX_DATA, for the edges
+//   SNAP_EDGE_BLOB        as SNAP_VERTEX_BLOB, for the edges
+//   SNAP_ADJ_OFFSETS      uint64[n + 1]    CSR row offsets; the adjacency of vertex i is [off[i], off[i + 1])
+//   SNAP_ADJ_EDGES        uint64[2m]   the edge (as an index into the edge arrays) of each adjacency entry, in adjacency list order;
+//                                      in directed snapshots, SNAP_ADJ_IN_ENTRY is set on the entries at the target end
+//   SNAP_ADJ_NEIGHBORS    uint64[2m]   the other end (as an index into the vertex arrays) of each adjacency entry
+
+static const uint32_t MYSNAPSHOT_VERSION = 2;
+static const uint32_t MYSNAPSHOT_ENDIAN_CHECK = 0x01020304;
+static const uint64_t SNAP_ADJ_IN_ENTRY = 1ULL << 63;      // the flag of SNAP_ADJ_EDGES entries an edge enters by (directed only)
+
+enum MySnapshotSection
+{
+    SNAP_VERTEX_IDS,
+    SNAP_VERTEX_TAGS,
+    SNAP_VERTEX_DATA,
+    SNAP_VERTEX_BLOB,
+    SNAP_EDGE_IDS,
+    SNAP_EDGE_SRC,
+    SNAP_EDGE_TGT,
+    SNAP_EDGE_TAGS,
+    SNAP_EDGE_DATA,
+    SNAP_EDGE_BLOB,
+    SNAP_ADJ_OFFSETS,
+    SNAP_ADJ_EDGES,
+    SNAP_ADJ_NEIGHBORS,
+    SNAP_NUM_SECTIONS
+};
+
+// how vertex and edge data are stored
+enum MySnapshotDataKind
+{
+    SNAP_DATA_FIXED = 1,        // trivially copyable values stored as raw bytes
+    SNAP_DATA_STRING = 2        // std::string values stored in a blob with an offset table
+};
+
+struct MySnapshotHeader
+{
+    char magic[8];                          // "MYGRAPH" followed by '\0'
+    uint32_t version;                       // MYSNAPSHOT_VERSION
+    uint32_t endian_check;                  // MYSNAPSHOT_ENDIAN_CHECK as written by the saving machine
+    uint32_t header_bytes;                  // sizeof(MySnapshotHeader)
+    uint32_t id_bytes;                      // sizeof(VertexIDType) and sizeof(EdgeIDType)
+    uint32_t vertex_data_kind;              // a MySnapshotDataKind
+    uint32_t vertex_data_bytes;             // sizeof the vertex data type (fixed-size data only)
+    uint32_t edge_data_kind;
+    uint32_t edge_data_bytes;
+    uint32_t directed;                      // 1 if written by a graph with a directed policy, 0 otherwise
+    uint32_t reserved;                      // 0
+    uint64_t num_vertices;
+    uint64_t num_edges;
+    uint64_t current_vertex_id;             // the last vertex ID handed out
+    uint64_t current_edge_id;               // the last edge ID handed out
+    uint64_t section_offset[SNAP_NUM_SECTIONS];     // the byte offset of each section from the start of the file
+    uint64_t section_bytes[SNAP_NUM_SECTIONS];      // the byte length of each section (without padding)
+    uint64_t file_bytes;                    // the total size of the file
+};
+
+static_assert(sizeof(MySnapshotHeader) % 8 == 0, "the sections following the header must stay 8-byte aligned");
+
+// encodes and decodes vertex/edge data of type DataType (in snapshots, and one value at a time in MyGraphLog records)
+// trivially copyable types are stored as raw bytes (empty ones, e.g. MyNoData, as no bytes); std::string has its own specialization below
+// other types cannot be saved (the static_assert fires when save or load is used with them)
+template <typename DataType>
+class MySnapshotCodec
+{
+    static_assert(std::is_trivially_copyable<DataType>::value,
+                  "MyGraph snapshots support trivially copyable data types and std::string only");
+
+  public:
+    static const uint32_t KIND = SNAP_DATA_FIXED;
+    static const uint32_t BYTES = (std::is_empty<DataType>::value ? 0 : sizeof(DataType));
+
+    // returns the byte length of the data section for n values
+    static uint64_t dataBytes(const uint64_t n)
+    {
+        return n * BYTES;
+    }
+
+    // writes the data section and the blob section of values[0 .. n) (accessed through get(i))
+    template <typename GetterType>
+    static void write(std::ostream& os, const size_t n, GetterType get, uint64_t& blob_bytes)
+    {
+        blob_bytes = 0;
+        if(BYTES == 0)
+        {
+            return;
+        }
+        for(size_t i = 0; i < n; ++ i)
+        {
+            os.write(reinterpret_cast<const char*>(&get(i)), BYTES);
+        }
+        return;
+    }
+
+    // writes the blob section (fixed-size data has none)
+    template <typename GetterType>
+    static void writeBlob(std::ostream&, const size_t, GetterType)
+    {
+        return;
+    }
+
+    // decodes value i from the data section (and the blob)
+    static void read(const char* data, const char*, const uint64_t, const size_t i, DataType& out)
+    {
+        std::memcpy(&out, data + i * BYTES, BYTES);
+    }
+
+    // checks the data section of n values against the blob length
+    static bool validate(const char*, const uint64_t data_bytes, const uint64_t blob_bytes, const uint64_t n)
+    {
+        return data_bytes == n * BYTES && blob_bytes == 0;
+    }
+
+    // appends the encoding of one value to out
+    static void append(std::string& out, const DataType& value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), BYTES);
+    }
+
+    // decodes one value from [p, end) and advances p past it
+    // returns false if the bytes are too short
+    static bool decode(const char*& p, const char* end, DataType& out)
+    {
+        if(static_cast<size_t>(end - p) < BYTES)
+        {
+            return false;
+        }
+        std::memcpy(&out, p, BYTES);
+        p += BYTES;
+        return true;
+    }
+};
+
+template <>
+class MySnapshotCodec<std::string>
+{
+  public:
+    static const uint32_t KIND = SNAP_DATA_STRING;
+    static const uint32_t BYTES = 0;
+
+    static uint64_t dataBytes(const uint64_t n)
+    {
+        return (n + 1) * sizeof(uint64_t);
+    }
+
+    // the offset table is written first, so the blob length is known before the strings are streamed
+    template <typename GetterType>
+    static void write(std::ostream& os, const size_t n, GetterType get, uint64_t& blob_bytes)
+    {
+        uint64_t off = 0;
+        os.write(reinterpret_cast<const char*>(&off), sizeof(off));
+        for(size_t i = 0; i < n; ++ i)
+        {
+            off += get(i).size();
+            os.write(reinterpret_cast<const char*>(&off), sizeof(off));
+        }
+        blob_bytes = off;
+        return;
+    }
+
+    // writes the blob section
+    template <typename GetterType>
+    static void writeBlob(std::ostream& os, const size_t n, GetterType get)
+    {
+        for(size_t i = 0; i < n; ++ i)
+        {
+            os.write(get(i).data(), get(i).size());
+        }
+        return;
+    }
+
+    static void read(const char* data, const char* blob, const uint64_t, const size_t i, std::string& out)
+    {
+        uint64_t lo, hi;
+        std::memcpy(&lo, data + i * sizeof(uint64_t), sizeof(uint64_t));
+        std::memcpy(&hi, data + (i + 1) * sizeof(uint64_t), sizeof(uint64_t));
+        out.assign(blob + lo, hi - lo);
+    }
+
+    // the offsets must start at 0, never decrease and end at the blob length
+    static bool validate(const char* data, const uint64_t data_bytes, const uint64_t blob_bytes, const uint64_t n)
+    {
+        if(data_bytes != (n + 1) * sizeof(uint64_t))
+        {
+            return false;
+        }
+        uint64_t prev = 0, off;
+        for(uint64_t i = 0; i <= n; ++ i)
+        {
+            std::memcpy(&off, data + i * sizeof(uint64_t), sizeof(uint64_t));
+            if(off < prev || (i == 0 && off != 0))
+            {
+                return false;
+            }
+            prev = off;
+        }
+        return prev == blob_bytes;
+    }
+
+    // a single value is its length (uint64) followed by its bytes
+    static void append(std::string& out, const std::string& value)
+    {
+        uint64_t len = value.size();
+        out.append(reinterpret_cast<const char*>(&len), sizeof(len));
+        out.append(value);
+    }
+
+    static bool decode(const char*& p, const char* end, std::string& out)
+    {
+        uint64_t len;
+        if(static_cast<size_t>(end - p) < sizeof(len))
+        {
+            return false;
+        }
+        std::memcpy(&len, p, sizeof(len));
+        if(static_cast<uint64_t>(end - p) - sizeof(len) < len)
+        {
+            return false;
+        }
+        out.assign(p + sizeof(len), len);
+        p += sizeof(len) + len;
+        return true;
+    }
+};
+
+// streams fixed-size values to os and pads the section to a multiple of 8 bytes
+// keeps track of the section offsets for the header
+class MySnapshotWriter
+{
+  private:
+    std::ostream& os;
+    uint64_t pos;                       // the number of bytes written so far
+    MySnapshotHeader& header;
+
+  public:
+    MySnapshotWriter(std::ostream& out, MySnapshotHeader& hdr) :
+        os(out),
+        pos(sizeof(MySnapshotHeader)),
+        header(hdr)
+    {
+        return;
+    }
+
+    // starts section s at the current position
+    void begin(const MySnapshotSection s)
+    {
+        header.section_offset[s] = pos;
+        return;
+    }
+
+    // ends section s after bytes bytes and pads to the next multiple of 8
+    void end(const MySnapshotSection s, const uint64_t bytes)
+    {
+        header.section_bytes[s] = bytes;
+        pos += bytes;
+        static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        if(pos % 8 != 0)
+        {
+            os.write(zeros, 8 - pos % 8);
+            pos += 8 - pos % 8;
+        }
+        return;
+    }
+
+    // writes a whole section of fixed-size values
+    template <typename ValueType>
+    void section(const MySnapshotSection s, const MyVector<ValueType>& values)
+    {
+        begin(s);
+        if(!values.empty())
+        {
+            os.write(reinterpret_cast<const char*>(&values[0]), values.size() * sizeof(ValueType));
+        }
+        end(s, values.size() * sizeof(ValueType));
+        return;
+    }
+
+    // returns the number of bytes written so far
+    uint64_t position() const
+    {
+        return pos;
+    }
+};
+
+// read-only access to the sections of a snapshot held in memory (e.g. by a MyMappedFile)
+// the arrays are used in place; nothing is copied or parsed
+class MySnapshotReader
+{
+  private:
+    const char* base;                   // the first byte of the snapshot
+    const MySnapshotHeader* header;
+
+  public:
+    // checks the header and the section table of the size bytes at data
+    // data must be 8-byte aligned (a mapping or a heap buffer is)
+    // throws std::domain_error if they do not describe a valid snapshot
+    MySnapshotReader(const char* data, const size_t size) :
+        base(data),
+        header(reinterpret_cast<const MySnapshotHeader*>(data))
+    {
+        if(size < sizeof(MySnapshotHeader) || std::memcmp(header->magic, "MYGRAPH", 8) != 0)
+        {
+            throw std::domain_error("MySnapshotReader: not a graph snapshot");
+        }
+        if(header->version != MYSNAPSHOT_VERSION)
+        {
+            throw std::domain_error("MySnapshotReader: unsupported snapshot version");
+        }
+        if(header->endian_check != MYSNAPSHOT_ENDIAN_CHECK || header->header_bytes != sizeof(MySnapshotHeader)
+           || header->id_bytes != sizeof(int64_t))
+        {
+            throw std::domain_error("MySnapshotReader: snapshot written on an incompatible platform");
+        }
+        if(header->directed > 1)
+        {
+            throw std::domain_error("MySnapshotReader: corrupted snapshot (policy)");
+        }
+        if(header->file_bytes != size)
+        {
+            throw std::domain_error("MySnapshotReader: snapshot truncated");
+        }
+        // every vertex and every edge takes at least 12 bytes, so larger counts cannot be genuine (and would overflow below)
+        const uint64_t n = header->num_vertices;
+        const uint64_t m = header->num_edges;
+        if(n > size / 12 || m > size / 12)
+        {
+            throw std::domain_error("MySnapshotReader: corrupted snapshot (counts)");
+        }
+        for(size_t s = 0; s < SNAP_NUM_SECTIONS; ++ s)
+        {
+            if(header->section_offset[s] % 8 != 0 || header->section_offset[s] < sizeof(MySnapshotHeader)
+               || header->section_offset[s] > size || header->section_bytes[s] > size - header->section_offset[s])
+            {
+                throw std::domain_error("MySnapshotReader: corrupted snapshot (section table)");
+            }
+        }
+        if(bytes(SNAP_VERTEX_IDS) != n * sizeof(int64_t) || bytes(SNAP_VERTEX_TAGS) != n * sizeof(int32_t)
+           || bytes(SNAP_EDGE_IDS) != m * sizeof(int64_t) || bytes(SNAP_EDGE_SRC) != m * sizeof(int64_t)
+           || bytes(SNAP_EDGE_TGT) != m * sizeof(int64_t) || bytes(SNAP_EDGE_TAGS) != m * sizeof(int32_t)
+           || bytes(SNAP_ADJ_OFFSETS) != (n + 1) * sizeof(uint64_t)
+           || bytes(SNAP_ADJ_EDGES) != 2 * m * sizeof(uint64_t) || bytes(SNAP_ADJ_NEIGHBORS) != 2 * m * sizeof(uint64_t))
+        {
+            throw std::domain_error("MySnapshotReader: corrupted snapshot (section sizes)");
+        }
+        return;
+    }
+
+    // returns the header
+    const MySnapshotHeader& info() const
+    {
+        return *header;
+    }
+
+    // returns the first element of section s
+    template <typename ValueType>
+    const ValueType* array(const MySnapshotSection s) const
+    {
+        return reinterpret_cast<const ValueType*>(base + header->section_offset[s]);
+    }
+
+    // returns the byte length of section s
+    uint64_t bytes(const MySnapshotSection s) const
+    {
+        return header->section_bytes[s];
+    }
+
+    // checks that the vertex and edge data were written for VertexDataType and EdgeDataType
+    // throws std::domain_error otherwise
+    template <typename VertexDataType, typename EdgeDataType>
+    void checkDataTypes() const
+    {
+        typedef MySnapshotCodec<VertexDataType> VertexCodec;
+        typedef MySnapshotCodec<EdgeDataType> EdgeCodec;
+        if(header->vertex_data_kind != VertexCodec::KIND || header->vertex_data_bytes != VertexCodec::BYTES
+           || header->edge_data_kind != EdgeCodec::KIND || header->edge_data_bytes != EdgeCodec::BYTES)
+        {
+            throw std::domain_error("MySnapshotReader: snapshot written for other vertex or edge data types");
+        }
+        if(!VertexCodec::validate(array<char>(SNAP_VERTEX_DATA), bytes(SNAP_VERTEX_DATA), bytes(SNAP_VERTEX_BLOB), header->num_vertices)
+           || !EdgeCodec::validate(array<char>(SNAP_EDGE_DATA), bytes(SNAP_EDGE_DATA), bytes(SNAP_EDGE_BLOB), header->num_edges))
+        {
+            throw std::domain_error("MySnapshotReader: corrupted snapshot (vertex or edge data)");
+        }
+        return;
+    }
+
+    // checks that the snapshot was written by a directed graph if directed is true, by an undirected one otherwise
+    // throws std::domain_error otherwise
+    void checkDirected(const bool directed) const
+    {
+        if((header->directed != 0) != directed)
+        {
+            throw std::domain_error(directed ? "MySnapshotReader: snapshot written for an undirected graph"
+                                             : "MySnapshotReader: snapshot written for a directed graph");
+        }
+        return;
+    }
+
+    // returns the edge position of the adjacency entry value (without the SNAP_ADJ_IN_ENTRY flag)
+    static uint64_t entryEdge(const uint64_t value)
+    {
+        return value & ~SNAP_ADJ_IN_ENTRY;
+    }
+
+    // checks the CSR adjacency: the row offsets run from 0 to 2m without decreasing,
+    // and every entry names an existing edge and an existing vertex (and carries no direction flag unless directed)
+    // throws std::domain_error otherwise
+    void checkAdjacency() const
+    {
+        const uint64_t n = header->num_vertices;
+        const uint64_t m = header->num_edges;
+        const uint64_t* off = array<uint64_t>(SNAP_ADJ_OFFSETS);
+        const uint64_t* adj_edges = array<uint64_t>(SNAP_ADJ_EDGES);
+        const uint64_t* adj_nbrs = array<uint64_t>(SNAP_ADJ_NEIGHBORS);
+        if(off[0] != 0 || off[n] != 2 * m)
+        {
+            throw std::domain_error("MySnapshotReader: corrupted snapshot (adjacency offsets)");
+        }
+        for(uint64_t i = 0; i < n; ++ i)
+        {
+            if(off[i] > off[i + 1])
+            {
+                throw std::domain_error("MySnapshotReader: corrupted snapshot (adjacency offsets)");
+            }
+        }
+        const uint64_t edge_mask = (header->directed != 0 ? ~SNAP_ADJ_IN_ENTRY : ~0ULL);
+        for(uint64_t k = 0; k < 2 * m; ++ k)
+        {
+            if((adj_edges[k] & edge_mask) >= m || adj_nbrs[k] >= n)
+            {
+                throw std::domain_error("MySnapshotReader: corrupted snapshot (adjacency entries)");
+            }
+        }
+        return;
+    }
+};
+
+#endif // __MYSNAPSHOT_H__
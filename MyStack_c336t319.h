@@ -63,6 +63,7 @@ class MyStack //: private MyVector<DataType>
         // code begins
         std::swap(myVec, rhs.myVec);
         rhs.myVec = MyVector<DataType>();
+        return *this;
         // code ends
     }
 
@@ -134,6 +135,12 @@ class MyStack //: private MyVector<DataType>
         // code ends
     }
 
+    // returns the heap bytes of the underlying vector (not counting memory owned by the elements)
+    size_t memoryUsage(void) const
+    {
+        return myVec.memoryUsage();
+    }
+
 };
 
 
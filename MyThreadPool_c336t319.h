@@ -0,0 +1,158 @@
+#ifndef __MYTHREADPOOL_H__
+#define __MYTHREADPOOL_H__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fixed-size pool of worker threads for fork-join parallel loops
+// the calling thread takes part in every job as thread 0, so a pool of n threads spawns n-1 workers
+// jobs must not throw and must not submit nested jobs to the same pool
+class MyThreadPool
+{
+  private:
+    std::vector<std::thread> workers;               // the spawned worker threads (thread IDs 1, 2, ..., n-1)
+    std::mutex mtx;                                 // guards all of the fields below
+    std::condition_variable cv_start;               // signals the workers that a new job is available
+    std::condition_variable cv_done;                // signals the caller that all workers finished the job
+    const std::function<void(size_t)>* task;        // the current job; called with the thread ID
+    unsigned long long generation;                  // the number of jobs started so far
+    size_t pending;                                 // the number of workers still running the current job
+    bool stopping;                                  // set by the destructor to shut the workers down
+
+    // the loop run by each worker thread
+    void workerLoop(const size_t tid)
+    {
+        unsigned long long seen = 0;
+        while(true)
+        {
+            const std::function<void(size_t)>* job;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv_start.wait(lock, [&] { return stopping || generation != seen; });
+                if(stopping)
+                {
+                    return;
+                }
+                seen = generation;
+                job = task;
+            }
+            (*job)(tid);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if(-- pending == 0)
+                {
+                    cv_done.notify_one();
+                }
+            }
+        }
+    }
+
+  public:
+
+    // default constructor; num_threads == 0 uses one thread per hardware thread
+    explicit MyThreadPool(size_t num_threads = 0) :
+        task(nullptr),
+        generation(0),
+        pending(0),
+        stopping(false)
+    {
+        if(num_threads == 0)
+        {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers.reserve(num_threads - 1);
+        for(size_t tid = 1; tid < num_threads; ++ tid)
+        {
+            workers.emplace_back(&MyThreadPool::workerLoop, this, tid);
+        }
+        return;
+    }
+
+    // destructor; stops and joins all worker threads
+    ~MyThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv_start.notify_all();
+        for(size_t i = 0; i < workers.size(); ++ i)
+        {
+            workers[i].join();
+        }
+        return;
+    }
+
+    MyThreadPool(const MyThreadPool&) = delete;
+    MyThreadPool& operator=(const MyThreadPool&) = delete;
+
+    // returns the number of threads taking part in a job (including the caller)
+    size_t numThreads() const
+    {
+        return workers.size() + 1;
+    }
+
+    // runs func(tid) once on every thread, tid = 0, 1, ..., numThreads()-1
+    // returns after all of them have finished
+    void run(const std::function<void(size_t)>& func)
+    {
+        if(workers.empty())
+        {
+            func(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            task = &func;
+            pending = workers.size();
+            ++ generation;
+        }
+        cv_start.notify_all();
+        func(0);
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_done.wait(lock, [&] { return pending == 0; });
+        return;
+    }
+
+    // splits [begin, end) into chunks of at most chunk indices and hands them out dynamically
+    // calls func(tid, lo, hi) for every chunk [lo, hi); returns after all chunks are done
+    void parallelFor(const size_t begin, const size_t end, size_t chunk, const std::function<void(size_t, size_t, size_t)>& func)
+    {
+        if(end <= begin)
+        {
+            return;
+        }
+        if(chunk == 0)
+        {
+            chunk = 1;
+        }
+        if(workers.empty() || end - begin <= chunk)
+        {
+            func(0, begin, end);
+            return;
+        }
+        std::atomic<size_t> cursor(begin);
+        run([&](size_t tid)
+        {
+            while(true)
+            {
+                size_t lo = cursor.fetch_add(chunk, std::memory_order_relaxed);
+                if(lo >= end)
+                {
+                    break;
+                }
+                func(tid, lo, std::min(end, lo + chunk));
+            }
+        });
+        return;
+    }
+
+};
+
+#endif // __MYTHREADPOOL_H__
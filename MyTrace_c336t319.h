@@ -0,0 +1,275 @@
+#ifndef __MYTRACE_H__
+#define __MYTRACE_H__
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// compile-time instrumentation level of the containers and the graph
+//   0: off; the macros below compile to nothing (default)
+//   1: counters (lookups, traversal work, rehashes, allocations; see MyMemory_c336t319.h)
+//   2: counters and trace messages sent to the trace sink
+//   3: counters, trace messages and timing spans (see MyTraceSpans::dumpChromeTrace)
+// define it before the first include (e.g. -DMYGRAPH_TRACE_LEVEL=2) to turn instrumentation on
+#ifndef MYGRAPH_TRACE_LEVEL
+#define MYGRAPH_TRACE_LEVEL 0
+#endif
+
+// adds n to an instrumentation counter (plain integer or std::atomic; see MyTrace::count)
+#if MYGRAPH_TRACE_LEVEL >= 1
+#define MYGRAPH_COUNT(counter, n) MyTrace::count((counter), (n))
+#else
+#define MYGRAPH_COUNT(counter, n) ((void)(n))
+#endif
+
+// formats stream_expr (anything that can follow "os <<") and sends it to the trace sink under category
+#if MYGRAPH_TRACE_LEVEL >= 2
+#define MYGRAPH_TRACE(category, stream_expr)                \
+    do                                                      \
+    {                                                       \
+        std::ostringstream mytrace_os_;                     \
+        mytrace_os_ << stream_expr;                         \
+        MyTrace::emit((category), mytrace_os_.str());       \
+    } while(0)
+#else
+#define MYGRAPH_TRACE(category, stream_expr) ((void)0)
+#endif
+
+// records a timing span named name from this point to the end of the enclosing scope
+#if MYGRAPH_TRACE_LEVEL >= 3
+#define MYGRAPH_SPAN_CONCAT_(a, b) a##b
+#define MYGRAPH_SPAN_CONCAT(a, b) MYGRAPH_SPAN_CONCAT_(a, b)
+#define MYGRAPH_SPAN(category, name) MyTraceSpan MYGRAPH_SPAN_CONCAT(mytrace_span_, __LINE__)((category), (name))
+#else
+#define MYGRAPH_SPAN(category, name) ((void)0)
+#endif
+
+// the number of spans each thread keeps; older spans are overwritten
+#ifndef MYGRAPH_SPAN_BUFFER_SIZE
+#define MYGRAPH_SPAN_BUFFER_SIZE 65536
+#endif
+
+// the pluggable destination of trace messages and counter reports
+// the default sink writes one line per message to std::cerr
+class MyTrace
+{
+  public:
+    typedef void (*SinkType)(const char* category, const std::string& message);
+
+    // writes "[category] message" to std::cerr
+    static void defaultSink(const char* category, const std::string& message)
+    {
+        std::cerr << "[" << category << "] " << message << "\n";
+    }
+
+    // replaces the sink; nullptr restores the default one
+    static void setSink(const SinkType new_sink)
+    {
+        sink().store(new_sink != nullptr ? new_sink : &MyTrace::defaultSink);
+    }
+
+    // sends a message to the current sink
+    static void emit(const char* category, const std::string& message)
+    {
+        sink().load()(category, message);
+    }
+
+    // adds n to an atomic counter; the counters order nothing, so relaxed ordering is enough
+    template <typename T, typename N>
+    static void count(std::atomic<T>& counter, const N n)
+    {
+        counter.fetch_add(static_cast<T>(n), std::memory_order_relaxed);
+    }
+
+    // adds n to a plain counter
+    template <typename T, typename N>
+    static void count(T& counter, const N n)
+    {
+        counter += n;
+    }
+
+  private:
+    // the current sink (a function-local static, so every translation unit shares it)
+    static std::atomic<SinkType>& sink()
+    {
+        static std::atomic<SinkType> current(&MyTrace::defaultSink);
+        return current;
+    }
+};
+
+// one recorded timing span; category and name must be string literals (only the pointers are kept)
+struct MyTraceSpanEvent
+{
+    const char* category;
+    const char* name;
+    long long start_ns;     // nanoseconds since MyTraceSpans::epoch()
+    long long dur_ns;
+};
+
+// the span ring buffer of one thread
+// only the owning thread writes; head is published with release semantics so a dump can read without locks
+struct MyTraceSpanBuffer
+{
+    MyTraceSpanEvent* events;                   // MYGRAPH_SPAN_BUFFER_SIZE slots
+    std::atomic<unsigned long long> head;       // the number of spans ever recorded; the next slot is head % size
+    unsigned tid;                               // the small sequential thread number shown in the trace
+    MyTraceSpanBuffer* next;                    // the next buffer in the registry
+};
+
+// the registry of per-thread span buffers and the Chrome trace-event (Perfetto) exporter
+// buffers are registered with a lock-free push on first use and stay alive until the process exits,
+// so spans of finished threads can still be dumped
+class MyTraceSpans
+{
+  public:
+    // returns the time origin of all spans
+    static std::chrono::steady_clock::time_point epoch()
+    {
+        static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+        return origin;
+    }
+
+    // returns the nanoseconds elapsed since epoch()
+    static long long now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch()).count();
+    }
+
+    // appends a span to the calling thread's ring buffer
+    static void record(const char* category, const char* name, const long long start_ns, const long long dur_ns)
+    {
+        MyTraceSpanBuffer* buf = localBuffer();
+        unsigned long long h = buf->head.load(std::memory_order_relaxed);
+        MyTraceSpanEvent& ev = buf->events[h % MYGRAPH_SPAN_BUFFER_SIZE];
+        ev.category = category;
+        ev.name = name;
+        ev.start_ns = start_ns;
+        ev.dur_ns = dur_ns;
+        buf->head.store(h + 1, std::memory_order_release);
+    }
+
+    // writes the spans of all threads as Chrome trace-event JSON (complete "X" events, timestamps in microseconds)
+    // spans recorded while the dump runs may or may not be included
+    static void dumpChromeTrace(std::ostream& os)
+    {
+        os << "{\"traceEvents\":[";
+        bool first = true;
+        for(MyTraceSpanBuffer* buf = registry().load(std::memory_order_acquire); buf != nullptr; buf = buf->next)
+        {
+            unsigned long long h = buf->head.load(std::memory_order_acquire);
+            unsigned long long begin = (h > MYGRAPH_SPAN_BUFFER_SIZE ? h - MYGRAPH_SPAN_BUFFER_SIZE : 0);
+            for(unsigned long long i = begin; i < h; ++ i)
+            {
+                const MyTraceSpanEvent& ev = buf->events[i % MYGRAPH_SPAN_BUFFER_SIZE];
+                os << (first ? "\n" : ",\n");
+                os << "{\"name\":\"" << ev.name << "\",\"cat\":\"" << ev.category << "\",\"ph\":\"X\""
+                   << ",\"ts\":" << ev.start_ns / 1000 << "." << padded(ev.start_ns % 1000)
+                   << ",\"dur\":" << ev.dur_ns / 1000 << "." << padded(ev.dur_ns % 1000)
+                   << ",\"pid\":1,\"tid\":" << buf->tid << "}";
+                first = false;
+            }
+        }
+        os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        return;
+    }
+
+    // writes the Chrome trace-event JSON to the file at path
+    // returns false if the file cannot be opened
+    static bool dumpChromeTrace(const std::string& path)
+    {
+        std::ofstream out(path.c_str());
+        if(!out.is_open())
+        {
+            return false;
+        }
+        dumpChromeTrace(out);
+        return out.good();
+    }
+
+    // drops all recorded spans; must not run concurrently with recording threads
+    static void clear()
+    {
+        for(MyTraceSpanBuffer* buf = registry().load(std::memory_order_acquire); buf != nullptr; buf = buf->next)
+        {
+            buf->head.store(0, std::memory_order_release);
+        }
+        return;
+    }
+
+  private:
+    // the head of the registry list
+    static std::atomic<MyTraceSpanBuffer*>& registry()
+    {
+        static std::atomic<MyTraceSpanBuffer*> head(nullptr);
+        return head;
+    }
+
+    // returns the calling thread's buffer, creating and registering it on first use
+    static MyTraceSpanBuffer* localBuffer()
+    {
+        thread_local MyTraceSpanBuffer* buf = nullptr;
+        if(buf == nullptr)
+        {
+            static std::atomic<unsigned> next_tid(1);
+            buf = new MyTraceSpanBuffer;
+            buf->events = new MyTraceSpanEvent[MYGRAPH_SPAN_BUFFER_SIZE];
+            buf->head.store(0, std::memory_order_relaxed);
+            buf->tid = next_tid.fetch_add(1);
+            buf->next = registry().load(std::memory_order_relaxed);
+            while(!registry().compare_exchange_weak(buf->next, buf, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+        return buf;
+    }
+
+    // formats the sub-microsecond part of a timestamp as three digits
+    static std::string padded(const long long ns)
+    {
+        std::string digits = std::to_string(ns);
+        return std::string(3 - digits.size(), '0') + digits;
+    }
+};
+
+// scoped timing span; records [construction, destruction) into the calling thread's ring buffer
+// use it through MYGRAPH_SPAN, which compiles to nothing below MYGRAPH_TRACE_LEVEL 3
+class MyTraceSpan
+{
+  private:
+    const char* category;
+    const char* name;
+    long long start_ns;
+
+  public:
+    MyTraceSpan(const char* span_category, const char* span_name) :
+        category(span_category),
+        name(span_name),
+        start_ns(MyTraceSpans::now())
+    {
+        return;
+    }
+
+    ~MyTraceSpan()
+    {
+        MyTraceSpans::record(category, name, start_ns, MyTraceSpans::now() - start_ns);
+    }
+
+    MyTraceSpan(const MyTraceSpan&) = delete;
+    MyTraceSpan& operator=(const MyTraceSpan&) = delete;
+};
+
+// a snapshot of the instrumentation counters of a graph
+// all counters stay zero unless MYGRAPH_TRACE_LEVEL >= 1
+struct MyGraphCounters
+{
+    unsigned long long vertex_lookups;      // vertex ID to position lookups
+    unsigned long long edge_lookups;        // edge ID to position lookups
+    unsigned long long traversal_vertices;  // vertices visited by traversals and searches
+    unsigned long long traversal_edges;     // adjacency entries examined by traversals and searches
+    unsigned long long rehashes;            // rehashes of the graph's hash tables
+};
+
+#endif // __MYTRACE_H__
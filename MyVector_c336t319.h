@@ -5,6 +5,8 @@
 #include <vector>
 #include <cstdlib>
 
+#include "MyMemory_c336t319.h"
+
 template <typename DataType>
 class MyVector
 {
@@ -25,6 +27,7 @@ class MyVector
     {
         // code begins
         data = new DataType[theCapacity];
+        MYGRAPH_COUNT_ALLOC(data, theCapacity * sizeof(DataType));
         // code ends
     }
 
@@ -35,7 +38,8 @@ class MyVector
     {
         // code begins
         data = new DataType[theCapacity];
-        for(int i = 0; i < theSize; ++i)
+        MYGRAPH_COUNT_ALLOC(data, theCapacity * sizeof(DataType));
+        for(size_t i = 0; i < theSize; ++i)
         {
             data[i] = rhs.data[i];
         }
@@ -62,7 +66,8 @@ class MyVector
     {
         // code begins
         data = new DataType[theCapacity];
-        for(int i = 0; i < theSize; ++i)
+        MYGRAPH_COUNT_ALLOC(data, theCapacity * sizeof(DataType));
+        for(size_t i = 0; i < theSize; ++i)
         {
             data[i] = rhs[i];
         }
@@ -72,6 +77,7 @@ class MyVector
     // destructor
     ~MyVector(){
         // code begins
+        MYGRAPH_COUNT_FREE(data, theCapacity * sizeof(DataType));
         delete[] data;
         // code ends
     };
@@ -98,6 +104,9 @@ class MyVector
             std::swap(theSize, rhs.theSize);
             std::swap(theCapacity, rhs.theCapacity);
             std::swap(data, rhs.data);
+            // rhs now holds the old storage of this vector; release it instead of dropping the pointer
+            MYGRAPH_COUNT_FREE(rhs.data, rhs.theCapacity * sizeof(DataType));
+            delete[] rhs.data;
             rhs.theSize = 0;
             rhs.theCapacity = 0;
             rhs.data = nullptr;
@@ -125,10 +134,12 @@ class MyVector
         if(newCapacity > theCapacity)
         {
             DataType *tmp = new DataType[newCapacity];
+            MYGRAPH_COUNT_ALLOC(tmp, newCapacity * sizeof(DataType));
             for(size_t i = 0; i < theSize; ++i)
             {
                 tmp[i] = std::move(data[i]);
             }
+            MYGRAPH_COUNT_FREE(data, theCapacity * sizeof(DataType));
             delete[] data;
             data = tmp;
             theCapacity = newCapacity;
@@ -176,6 +187,12 @@ class MyVector
         // code ends
     }
 
+    // returns the heap bytes of the storage array (the full capacity; not counting memory owned by the elements)
+    size_t memoryUsage() const
+    {
+        return theCapacity * sizeof(DataType);
+    }
+
     // insert an data element to the end of the vector
     void push_back(const DataType & x)
     {